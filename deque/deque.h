@@ -1,37 +1,70 @@
 #pragma once
+#include <algorithm>
+#include <bit>
 #include <compare>
+#include <cstring>
+#include <initializer_list>
 #include <iterator>
+#include <memory>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
-int DivisionUp(int divisible, int divider) {
-  return (divisible + divider - 1) / divider;
-}
+template <size_t BudgetBytes = 4096, size_t MinElements = 16>
+struct DequeChunkBudget {
+  template <typename T>
+  static constexpr size_t elements() {
+    return std::bit_floor(std::max(BudgetBytes / sizeof(T), MinElements));
+  }
+};
 
-template <typename T>
+template <typename T, typename ChunkPolicy = DequeChunkBudget<>>
 class Deque {
  private:
-  static const size_t kSizeArray = 32;
+  static constexpr size_t kSizeArray = ChunkPolicy::template elements<T>();
+  static_assert(std::has_single_bit(kSizeArray),
+                "Deque chunk size must be a power of two");
+  static constexpr int kChunkShift = std::countr_zero(kSizeArray);
+  static constexpr size_t kChunkMask = kSizeArray - 1;
+  static constexpr T* kEmptyMap[1] = {nullptr};
+  static const size_t kMaxSpareChunks = 4;
   size_t size_;
   size_t capacity_;
-  int ptr_first_array_;
-  int ptr_last_array_;
-  int ptr_first_elem_;
-  int ptr_last_elem_;
+  size_t ptr_first_;
   std::vector<T*> vector_arrays_;
+  T* spare_chunks_[kMaxSpareChunks];
+  size_t spare_count_ = 0;
   T* alloc(size_t size) {
     return reinterpret_cast<T*>(new char[size * sizeof(T)]);
   }
   void dealloc(T* arr) { delete[] reinterpret_cast<char*>(arr); }
-  std::vector<T*> reserve(size_t new_cap);
-  void unreserve(std::vector<T*>& reserved_vector, int old_ptr_first_arr);
-  static void increment_ptr(int& ptr_arr, int& ptr_elem);
-  static void decrement_ptr(int& ptr_arr, int& ptr_elem);
-  void push(const T& value, std::pair<int&, int&> ptr,
-            void (*change_ptr)(int&, int&), void (*undo_change_ptr)(int&, int&),
-            bool reserved);
+  void reserve(size_t new_cap);
+  void grow(size_t extra_arrays = 0) {
+    reserve(std::max(2 * capacity_, used_arrays() + 2 * extra_arrays + 2));
+  }
+  void reserve_front(size_t count);
+  void reserve_back(size_t count);
+  T* take_chunk();
+  void release_chunk(size_t ptr_arr);
+  template <typename... Args>
+  T* construct(size_t position, Args&&... args);
+  template <typename Iterator>
+  void construct_range(size_t position, Iterator first, size_t count);
+  void destroy_range(size_t position, size_t count);
   void free_memory();
+  void reset();
+  size_t used_arrays() const {
+    size_t first_array = ptr_first_ >> kChunkShift;
+    return ((ptr_first_ + size_) >> kChunkShift) - first_array + 1;
+  }
+  T* const* map() const {
+    return vector_arrays_.empty() ? kEmptyMap : vector_arrays_.data();
+  }
+  T* slot(size_t position) const {
+    return vector_arrays_[position >> kChunkShift] + (position & kChunkMask);
+  }
+  T* element(size_t index) const { return slot(ptr_first_ + index); }
   void alloc_arrays();
 
  public:
@@ -44,61 +77,102 @@ class Deque {
   using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
   Deque();
-  Deque(const Deque<T>& deque);
-  explicit Deque(int size);
-  Deque(int size, const T& value);
+  Deque(const Deque& deque);
+  Deque(Deque&& deque) noexcept;
+  explicit Deque(size_t size);
+  Deque(size_t size, const T& value);
+  template <std::input_iterator InputIt>
+  Deque(InputIt first, InputIt last);
+  Deque(std::initializer_list<T> list) : Deque(list.begin(), list.end()) {}
   Deque& operator=(const Deque& deque);
+  Deque& operator=(Deque&& deque) noexcept;
   [[nodiscard]] size_t size() const { return size_; }
-  T& operator[](size_t index) { return *(begin() + index); }
-  const T& operator[](size_t index) const { return *(begin() + index); }
+  T& operator[](size_t index) { return *element(index); }
+  const T& operator[](size_t index) const { return *element(index); }
   T& at(size_t index);
+  T& front() { return *element(0); }
+  const T& front() const { return *element(0); }
+  T& back() { return *element(size_ - 1); }
+  const T& back() const { return *element(size_ - 1); }
   [[nodiscard]] const T& at(size_t index) const {
-    return const_cast<Deque<T>&>(*this).at(index);
+    return const_cast<Deque&>(*this).at(index);
+  }
+  template <std::input_iterator InputIt>
+  void assign(InputIt first, InputIt last);
+  void assign(std::initializer_list<T> list) {
+    assign(list.begin(), list.end());
   }
-  void push_back(const T& value);
+  template <std::input_iterator InputIt>
+  void append(InputIt first, InputIt last);
+  template <std::input_iterator InputIt>
+  void prepend(InputIt first, InputIt last);
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+  template <typename... Args>
+  T& emplace_back(Args&&... args);
   void pop_back();
-  void push_front(const T& value);
+  void push_front(const T& value) { emplace_front(value); }
+  void push_front(T&& value) { emplace_front(std::move(value)); }
+  template <typename... Args>
+  T& emplace_front(Args&&... args);
   void pop_front();
   iterator begin() {
-    return {&vector_arrays_, ptr_first_array_, ptr_first_elem_};
+    return {map() + (ptr_first_ >> kChunkShift), ptr_first_ & kChunkMask};
   }
   iterator end();
   [[nodiscard]] const_iterator cbegin() const {
-    return {&vector_arrays_, ptr_first_array_, ptr_first_elem_};
+    return {map() + (ptr_first_ >> kChunkShift), ptr_first_ & kChunkMask};
   }
   const_iterator cend() const;
   const_iterator begin() const { return cbegin(); };
   const_iterator end() const { return cend(); }
   reverse_iterator rbegin() { return reverse_iterator(end()); }
   reverse_iterator rend() { return reverse_iterator(begin()); }
-  const_iterator crbegin() const { return const_reverse_iterator(end()); }
-  const_iterator crend() const { return const_reverse_iterator(begin()); }
+  const_reverse_iterator crbegin() const {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator crend() const {
+    return const_reverse_iterator(begin());
+  }
   const_reverse_iterator rbegin() const { return crbegin(); }
   const_reverse_iterator rend() const { return crend(); }
-  void insert(iterator insert_it, const T& value);
-  void erase(iterator erase_it);
+  template <typename... Args>
+  iterator emplace(const_iterator pos, Args&&... args);
+  iterator insert(const_iterator pos, const T& value) {
+    return emplace(pos, value);
+  }
+  iterator insert(const_iterator pos, T&& value) {
+    return emplace(pos, std::move(value));
+  }
+  template <std::input_iterator InputIt>
+  iterator insert(const_iterator pos, InputIt first, InputIt last);
+  iterator erase(const_iterator pos) { return erase(pos, std::next(pos)); }
+  iterator erase(const_iterator first, const_iterator last);
+  void swap(Deque& deque) noexcept;
+  void shrink_to_fit();
   ~Deque() { free_memory(); }
-};
 
-template <typename T>
-template <bool IsConst>
-class Deque<T>::CommonIterator {
  private:
-  using ptr_to_vector_type =
-      typename std::conditional_t<IsConst, const std::vector<T*>*,
-                                  std::vector<T*>*>;
-  ptr_to_vector_type ptr_to_vector_;
-  int ptr_array_;
-  int ptr_elem_;
+  template <typename Iterator>
+  iterator insert_counted(const_iterator pos, Iterator first, size_t count);
+  template <typename Iterator>
+  void append_counted(Iterator first, size_t count);
+  template <typename Iterator>
+  void prepend_counted(Iterator first, size_t count);
+};
 
+template <typename T, typename ChunkPolicy>
+template <bool IsConst>
+class Deque<T, ChunkPolicy>::CommonIterator {
  public:
-  using value_type = typename std::conditional_t<IsConst, const T, T>;
+  using value_type = T;
   using iterator_category = std::random_access_iterator_tag;
-  using difference_type = int;
-  using pointer = value_type*;
-  using reference = value_type&;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::conditional_t<IsConst, const T, T>*;
+  using reference = std::conditional_t<IsConst, const T, T>&;
 
-  CommonIterator(ptr_to_vector_type ptr_to_vector, int ptr_array, int ptr_elem);
+  CommonIterator() = default;
+  CommonIterator(T* const* node, size_t ptr_elem);
   CommonIterator& operator++();
   CommonIterator operator++(int);
   CommonIterator& operator--();
@@ -107,150 +181,234 @@ class Deque<T>::CommonIterator {
   CommonIterator& operator-=(difference_type n) { return *this += -n; }
   CommonIterator operator+(difference_type n) const;
   CommonIterator operator-(difference_type n) const { return *this + (-n); }
-  reference operator*() const {
-    return (*ptr_to_vector_)[ptr_array_][ptr_elem_];
-  }
-  pointer operator->() const {
-    return (*ptr_to_vector_)[ptr_array_] + ptr_elem_;
+  friend CommonIterator operator+(difference_type n,
+                                  const CommonIterator& iterator) {
+    return iterator + n;
   }
+  reference operator[](difference_type n) const { return *(*this + n); }
+  reference operator*() const { return *current_; }
+  pointer operator->() const { return current_; }
   std::strong_ordering operator<=>(const CommonIterator& iterator) const;
-  explicit operator int() const { return ptr_array_ * kSizeArray + ptr_elem_; }
-  operator CommonIterator<true>() const { return *this; }
+  operator CommonIterator<true>() const {
+    return {node_, current_, chunk_begin_, chunk_end_};
+  }
   difference_type operator-(const CommonIterator& iterator) const {
-    return static_cast<int>(*this) - static_cast<int>(iterator);
+    return static_cast<difference_type>(
+        ((node_ - iterator.node_) << kChunkShift) + (current_ - chunk_begin_) -
+        (iterator.current_ - iterator.chunk_begin_));
   }
   bool operator==(const CommonIterator& iterator) const {
-    return static_cast<int>(*this) == static_cast<int>(iterator);
+    return current_ == iterator.current_ and node_ == iterator.node_;
   }
-};
 
-template <typename T>
-std::vector<T*> Deque<T>::reserve(size_t new_cap) {
-  for (int i = 0; i < ptr_first_array_; ++i) {
-    dealloc(vector_arrays_[i]);
-  }
-  for (int i = ptr_last_array_ + 1; i < static_cast<int>(capacity_); ++i) {
-    dealloc(vector_arrays_[i]);
+ private:
+  template <bool>
+  friend class CommonIterator;
+  friend class Deque;
+
+  T* const* node_ = nullptr;
+  pointer current_ = nullptr;
+  pointer chunk_begin_ = nullptr;
+  pointer chunk_end_ = nullptr;
+
+  CommonIterator(T* const* node, pointer current, pointer chunk_begin,
+                 pointer chunk_end)
+      : node_(node),
+        current_(current),
+        chunk_begin_(chunk_begin),
+        chunk_end_(chunk_end) {}
+  void set_node(T* const* node) {
+    node_ = node;
+    chunk_begin_ = *node;
+    chunk_end_ = chunk_begin_ == nullptr ? nullptr : chunk_begin_ + kSizeArray;
   }
-  std::vector<T*> new_vector_arrays(new_cap);
-  size_t free_space = new_cap - (ptr_last_array_ - ptr_first_array_ + 1);
-  size_t free_space_before_main = free_space / 2;
-  size_t free_space_after_main = free_space - free_space_before_main;
-  for (size_t i = 0; i < new_cap; ++i) {
-    if (i >= free_space_before_main and i < new_cap - free_space_after_main and
-        size_ != 0) {
-      new_vector_arrays[i] =
-          vector_arrays_[ptr_first_array_ + i - free_space_before_main];
-    } else {
-      new_vector_arrays[i] = alloc(kSizeArray);
+};
+
+template <typename T, typename ChunkPolicy>
+void Deque<T, ChunkPolicy>::reserve(size_t new_cap) {
+  size_t first_array = ptr_first_ >> kChunkShift;
+  size_t used = used_arrays();
+  std::vector<T*> new_vector_arrays(new_cap + 1, nullptr);
+  size_t new_first_array = (new_cap - used) / 2;
+  for (size_t i = 0; i < capacity_; ++i) {
+    if (i >= first_array and i - first_array < used) {
+      new_vector_arrays[new_first_array + i - first_array] = vector_arrays_[i];
+    } else if (vector_arrays_[i] != nullptr) {
+      release_chunk(i);
     }
   }
-  ptr_first_array_ = static_cast<int>(free_space_before_main);
-  ptr_last_array_ = static_cast<int>(new_cap - free_space_after_main - 1);
+  ptr_first_ = (new_first_array << kChunkShift) + (ptr_first_ & kChunkMask);
   capacity_ = new_cap;
-  std::swap(new_vector_arrays, vector_arrays_);
-  return new_vector_arrays;
+  vector_arrays_.swap(new_vector_arrays);
 }
 
-template <typename T>
-void Deque<T>::unreserve(std::vector<T*>& reserved_vector,
-                         int old_ptr_first_arr) {
-  std::swap(reserved_vector, vector_arrays_);
-  for (int i = 0; i < ptr_first_array_; ++i) {
-    dealloc(reserved_vector[i]);
+template <typename T, typename ChunkPolicy>
+void Deque<T, ChunkPolicy>::reserve_front(size_t count) {
+  if (ptr_first_ < count) {
+    size_t missing = count - (ptr_first_ & kChunkMask);
+    grow((missing + kSizeArray - 1) >> kChunkShift);
   }
-  for (int i = ptr_last_array_ + 1; i < static_cast<int>(capacity_); ++i) {
-    dealloc(reserved_vector[i]);
+  if (count == 0) {
+    return;
   }
-  ptr_first_array_ = old_ptr_first_arr;
-  capacity_ = vector_arrays_.size();
-  ptr_last_array_ = ptr_first_array_ + capacity_ - 1;
-  for (int i = 0; i < ptr_first_array_; ++i) {
-    vector_arrays_[i] = alloc(kSizeArray);
+  // The chunk holding ptr_first_ - 1 may be missing even when it also holds
+  // the first element's slot: an empty copy keeps the offset but no chunks.
+  size_t first_array = (ptr_first_ - count) >> kChunkShift;
+  size_t last_array = (ptr_first_ - 1) >> kChunkShift;
+  for (size_t i = first_array; i <= last_array; ++i) {
+    if (vector_arrays_[i] == nullptr) {
+      vector_arrays_[i] = take_chunk();
+    }
   }
-  for (int i = ptr_last_array_ + 1; i < static_cast<int>(capacity_); ++i) {
-    vector_arrays_[i] = alloc(kSizeArray);
+}
+
+template <typename T, typename ChunkPolicy>
+void Deque<T, ChunkPolicy>::reserve_back(size_t count) {
+  if (count == 0) {
+    return;
+  }
+  size_t end_position = ptr_first_ + size_;
+  size_t last_array = (end_position + count - 1) >> kChunkShift;
+  if (last_array >= capacity_) {
+    grow(last_array - (end_position >> kChunkShift));
+    end_position = ptr_first_ + size_;
+    last_array = (end_position + count - 1) >> kChunkShift;
+  }
+  for (size_t i = end_position >> kChunkShift; i <= last_array; ++i) {
+    if (vector_arrays_[i] == nullptr) {
+      vector_arrays_[i] = take_chunk();
+    }
   }
 }
 
-template <typename T>
-void Deque<T>::increment_ptr(int& ptr_arr, int& ptr_elem) {
-  ptr_arr += (++ptr_elem / static_cast<int>(kSizeArray));
-  ptr_elem %= static_cast<int>(kSizeArray);
+template <typename T, typename ChunkPolicy>
+T* Deque<T, ChunkPolicy>::take_chunk() {
+  if (spare_count_ != 0) {
+    return spare_chunks_[--spare_count_];
+  }
+  return alloc(kSizeArray);
 }
 
-template <typename T>
-void Deque<T>::decrement_ptr(int& ptr_arr, int& ptr_elem) {
-  if (ptr_elem == 0) {
-    --ptr_arr;
+template <typename T, typename ChunkPolicy>
+void Deque<T, ChunkPolicy>::release_chunk(size_t ptr_arr) {
+  if (spare_count_ < kMaxSpareChunks) {
+    spare_chunks_[spare_count_++] = vector_arrays_[ptr_arr];
+  } else {
+    dealloc(vector_arrays_[ptr_arr]);
   }
-  ptr_elem = (static_cast<int>(kSizeArray) + ptr_elem - 1) %
-             static_cast<int>(kSizeArray);
+  vector_arrays_[ptr_arr] = nullptr;
 }
 
-template <typename T>
-void Deque<T>::push(const T& value, std::pair<int&, int&> ptr,
-                    void (*change_ptr)(int&, int&),
-                    void (*undo_change_ptr)(int&, int&), bool reserved) {
-  int& ptr_arr = ptr.first;
-  int& ptr_elem = ptr.second;
-  std::vector<T*> new_vector_arrays;
-  int old_ptr_first_array = ptr_first_array_;
-  if (reserved) {
-    new_vector_arrays =
-        reserve(std::max(2 * capacity_, static_cast<size_t>(3)));
+template <typename T, typename ChunkPolicy>
+template <typename... Args>
+T* Deque<T, ChunkPolicy>::construct(size_t position, Args&&... args) {
+  size_t ptr_arr = position >> kChunkShift;
+  bool fresh_chunk = vector_arrays_[ptr_arr] == nullptr;
+  if (fresh_chunk) {
+    vector_arrays_[ptr_arr] = take_chunk();
   }
+  T* slot = vector_arrays_[ptr_arr] + (position & kChunkMask);
   try {
-    change_ptr(ptr_arr, ptr_elem);
-    new (vector_arrays_[ptr_arr] + ptr_elem) T(value);
-    ++size_;
+    new (slot) T(std::forward<Args>(args)...);
   } catch (...) {
-    undo_change_ptr(ptr_arr, ptr_elem);
-    if (reserved) {
-      unreserve(new_vector_arrays, old_ptr_first_array);
+    if (fresh_chunk) {
+      release_chunk(ptr_arr);
+    }
+    throw;
+  }
+  return slot;
+}
+
+template <typename T, typename ChunkPolicy>
+template <typename Iterator>
+void Deque<T, ChunkPolicy>::construct_range(size_t position, Iterator first,
+                                            size_t count) {
+  size_t constructed = 0;
+  try {
+    while (constructed < count) {
+      size_t offset = (position + constructed) & kChunkMask;
+      size_t run = std::min(count - constructed, kSizeArray - offset);
+      T* target = slot(position + constructed);
+      if constexpr (std::contiguous_iterator<Iterator> and
+                    std::is_trivially_copyable_v<T> and
+                    std::is_same_v<std::iter_value_t<Iterator>, T>) {
+        std::memcpy(target, std::to_address(first), run * sizeof(T));
+        first += run;
+      } else if constexpr ((std::is_same_v<Iterator, iterator> or
+                            std::is_same_v<Iterator, const_iterator>) and
+                           std::is_trivially_copyable_v<T>) {
+        run = std::min<size_t>(run, first.chunk_end_ - first.current_);
+        std::memcpy(target, first.current_, run * sizeof(T));
+        first += run;
+      } else {
+        first = std::ranges::uninitialized_copy_n(first, run, target,
+                                                  target + run)
+                    .in;
+      }
+      constructed += run;
     }
+  } catch (...) {
+    destroy_range(position, constructed);
     throw;
   }
 }
 
-template <typename T>
-void Deque<T>::free_memory() {
-  for (auto iterator = begin(); iterator != end(); ++iterator) {
-    iterator->~T();
+template <typename T, typename ChunkPolicy>
+void Deque<T, ChunkPolicy>::destroy_range(size_t position, size_t count) {
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    for (size_t i = 0; i < count; ++i) {
+      slot(position + i)->~T();
+    }
+  }
+}
+
+template <typename T, typename ChunkPolicy>
+void Deque<T, ChunkPolicy>::free_memory() {
+  if constexpr (!std::is_trivially_destructible_v<T>) {
+    for (auto iterator = begin(); iterator != end(); ++iterator) {
+      iterator->~T();
+    }
   }
   for (size_t i = 0; i < capacity_; ++i) {
     dealloc(vector_arrays_[i]);
   }
+  for (size_t i = 0; i < spare_count_; ++i) {
+    dealloc(spare_chunks_[i]);
+  }
 }
 
-template <typename T>
-void Deque<T>::alloc_arrays() {
-  for (size_t i = 0; i < capacity_; ++i) {
+template <typename T, typename ChunkPolicy>
+void Deque<T, ChunkPolicy>::reset() {
+  size_ = 0;
+  capacity_ = 0;
+  ptr_first_ = 0;
+  std::vector<T*>().swap(vector_arrays_);
+  spare_count_ = 0;
+}
+
+template <typename T, typename ChunkPolicy>
+void Deque<T, ChunkPolicy>::alloc_arrays() {
+  if (size_ == 0) {
+    return;
+  }
+  size_t last_array = (ptr_first_ + size_ - 1) >> kChunkShift;
+  for (size_t i = ptr_first_ >> kChunkShift; i <= last_array; ++i) {
     vector_arrays_[i] = alloc(kSizeArray);
   }
 }
 
-template <typename T>
-Deque<T>::Deque()
-    : size_(0),
-      capacity_(0),
-      ptr_first_array_(0),
-      ptr_last_array_(-1),
-      ptr_first_elem_(0),
-      ptr_last_elem_(static_cast<int>(kSizeArray - 1)) {}
-
-template <typename T>
-Deque<T>::Deque(int size) : Deque(size, T()) {}
-
-template <typename T>
-Deque<T>::Deque(int size, const T& value)
-    : size_(static_cast<size_t>(size)),
-      capacity_(DivisionUp(size_, kSizeArray)),
-      ptr_first_array_(0),
-      ptr_last_array_(capacity_ - 1),
-      ptr_first_elem_(0),
-      ptr_last_elem_((size - 1) % static_cast<int>(kSizeArray)),
-      vector_arrays_(capacity_) {
+template <typename T, typename ChunkPolicy>
+Deque<T, ChunkPolicy>::Deque() : size_(0), capacity_(0), ptr_first_(0) {}
+
+template <typename T, typename ChunkPolicy>
+Deque<T, ChunkPolicy>::Deque(size_t size) : Deque(size, T()) {}
+
+template <typename T, typename ChunkPolicy>
+Deque<T, ChunkPolicy>::Deque(size_t size, const T& value)
+    : size_(size),
+      capacity_((size_ + kSizeArray - 1) >> kChunkShift),
+      ptr_first_(0),
+      vector_arrays_(capacity_ + 1) {
   alloc_arrays();
   iterator creating_it = begin();
   try {
@@ -269,16 +427,31 @@ Deque<T>::Deque(int size, const T& value)
   }
 }
 
-template <typename T>
-Deque<T>::Deque(const Deque<T>& deque)
+template <typename T, typename ChunkPolicy>
+template <std::input_iterator InputIt>
+Deque<T, ChunkPolicy>::Deque(InputIt first, InputIt last) : Deque() {
+  append(first, last);
+}
+
+template <typename T, typename ChunkPolicy>
+Deque<T, ChunkPolicy>::Deque(const Deque& deque)
     : size_(deque.size_),
       capacity_(deque.capacity_),
-      ptr_first_array_(deque.ptr_first_array_),
-      ptr_last_array_(deque.ptr_last_array_),
-      ptr_first_elem_(deque.ptr_first_elem_),
-      ptr_last_elem_(deque.ptr_last_elem_),
-      vector_arrays_(capacity_) {
+      ptr_first_(deque.ptr_first_),
+      vector_arrays_(capacity_ + 1) {
   alloc_arrays();
+  if constexpr (std::is_trivially_copyable_v<T>) {
+    for (size_t position = ptr_first_; position != ptr_first_ + size_;) {
+      size_t ptr_arr = position >> kChunkShift;
+      size_t chunk_end = (ptr_arr + 1) << kChunkShift;
+      size_t count = std::min(ptr_first_ + size_, chunk_end) - position;
+      size_t ptr_elem = position & kChunkMask;
+      std::memcpy(vector_arrays_[ptr_arr] + ptr_elem,
+                  deque.vector_arrays_[ptr_arr] + ptr_elem, count * sizeof(T));
+      position += count;
+    }
+    return;
+  }
   iterator creating_it = begin();
   try {
     for (const_iterator deque_it = deque.begin(); creating_it != end();
@@ -297,176 +470,377 @@ Deque<T>::Deque(const Deque<T>& deque)
   }
 }
 
-template <typename T>
-Deque<T>& Deque<T>::operator=(const Deque<T>& deque) {
-  free_memory();
-  size_ = deque.size_;
-  capacity_ = deque.capacity_;
-  ptr_first_array_ = deque.ptr_first_array_;
-  ptr_last_array_ = deque.ptr_last_array_;
-  ptr_first_array_ = deque.ptr_first_elem_;
-  ptr_last_elem_ = deque.ptr_last_elem_;
-  vector_arrays_.reserve(capacity_);
-  alloc_arrays();
-  iterator internal_it = begin();
-  for (auto deque_it = deque.begin();
-       internal_it != end() or deque_it != deque.end();
-       ++internal_it, ++deque_it) {
-    new (internal_it.operator->()) T(*deque_it);
+template <typename T, typename ChunkPolicy>
+Deque<T, ChunkPolicy>::Deque(Deque&& deque) noexcept
+    : size_(deque.size_),
+      capacity_(deque.capacity_),
+      ptr_first_(deque.ptr_first_),
+      vector_arrays_(std::move(deque.vector_arrays_)),
+      spare_count_(deque.spare_count_) {
+  std::copy(deque.spare_chunks_, deque.spare_chunks_ + spare_count_,
+            spare_chunks_);
+  deque.reset();
+}
+
+template <typename T, typename ChunkPolicy>
+Deque<T, ChunkPolicy>& Deque<T, ChunkPolicy>::operator=(const Deque& deque) {
+  if (this != &deque) {
+    Deque copy(deque);
+    swap(copy);
   }
   return *this;
 }
 
-template <typename T>
-T& Deque<T>::at(size_t index) {
+template <typename T, typename ChunkPolicy>
+Deque<T, ChunkPolicy>& Deque<T, ChunkPolicy>::operator=(
+    Deque&& deque) noexcept {
+  Deque moved(std::move(deque));
+  swap(moved);
+  return *this;
+}
+
+template <typename T, typename ChunkPolicy>
+T& Deque<T, ChunkPolicy>::at(size_t index) {
   if (index >= size_) {
     throw std::out_of_range("Следи за тем, куда обращаешься, чувак");
   }
   return (*this)[index];
 }
 
-template <typename T>
-void Deque<T>::push_back(const T& value) {
-  bool reserved = ptr_last_elem_ + 1 == static_cast<int>(kSizeArray) and
-                  ptr_last_array_ + 1 == static_cast<int>(capacity_);
-  push(value, {ptr_last_array_, ptr_last_elem_}, &Deque::increment_ptr,
-       &Deque::decrement_ptr, reserved);
+template <typename T, typename ChunkPolicy>
+template <typename... Args>
+T& Deque<T, ChunkPolicy>::emplace_back(Args&&... args) {
+  if (((ptr_first_ + size_) >> kChunkShift) >= capacity_) {
+    grow();
+  }
+  T* slot = construct(ptr_first_ + size_, std::forward<Args>(args)...);
+  ++size_;
+  return *slot;
 }
 
-template <typename T>
-void Deque<T>::pop_back() {
-  --size_;
-  (vector_arrays_[ptr_last_array_] + ptr_last_elem_)->~T();
-  decrement_ptr(ptr_last_array_, ptr_last_elem_);
+template <typename T, typename ChunkPolicy>
+void Deque<T, ChunkPolicy>::pop_back() {
+  size_t position = ptr_first_ + --size_;
+  element(size_)->~T();
+  if ((position & kChunkMask) == 0) {
+    release_chunk(position >> kChunkShift);
+  }
 }
 
-template <typename T>
-void Deque<T>::push_front(const T& value) {
-  bool reserved = ptr_first_array_ == 0 and ptr_first_elem_ == 0;
-  push(value, {ptr_first_array_, ptr_first_elem_}, &Deque::decrement_ptr,
-       &Deque::increment_ptr, reserved);
+template <typename T, typename ChunkPolicy>
+template <typename... Args>
+T& Deque<T, ChunkPolicy>::emplace_front(Args&&... args) {
+  if (ptr_first_ == 0) {
+    grow();
+  }
+  T* slot = construct(ptr_first_ - 1, std::forward<Args>(args)...);
+  --ptr_first_;
+  ++size_;
+  return *slot;
 }
 
-template <typename T>
-void Deque<T>::pop_front() {
+template <typename T, typename ChunkPolicy>
+void Deque<T, ChunkPolicy>::pop_front() {
+  size_t position = ptr_first_;
+  element(0)->~T();
+  ++ptr_first_;
   --size_;
-  (vector_arrays_[ptr_first_array_] + ptr_first_elem_)->~T();
-  increment_ptr(ptr_first_array_, ptr_first_elem_);
+  if ((ptr_first_ & kChunkMask) == 0) {
+    release_chunk(position >> kChunkShift);
+  }
+}
+
+template <typename T, typename ChunkPolicy>
+typename Deque<T, ChunkPolicy>::iterator Deque<T, ChunkPolicy>::end() {
+  size_t position = ptr_first_ + size_;
+  return {map() + (position >> kChunkShift), position & kChunkMask};
+}
+
+template <typename T, typename ChunkPolicy>
+typename Deque<T, ChunkPolicy>::const_iterator Deque<T, ChunkPolicy>::cend()
+    const {
+  size_t position = ptr_first_ + size_;
+  return {map() + (position >> kChunkShift), position & kChunkMask};
+}
+
+template <typename T, typename ChunkPolicy>
+template <typename... Args>
+typename Deque<T, ChunkPolicy>::iterator Deque<T, ChunkPolicy>::emplace(
+    const_iterator pos, Args&&... args) {
+  size_t index = pos - cbegin();
+  if (index == 0) {
+    emplace_front(std::forward<Args>(args)...);
+    return begin();
+  }
+  if (index == size_) {
+    emplace_back(std::forward<Args>(args)...);
+    return end() - 1;
+  }
+  T value(std::forward<Args>(args)...);
+  if (index < size_ - index) {
+    emplace_front(std::move(front()));
+    std::move(begin() + 2, begin() + index + 1, begin() + 1);
+  } else {
+    emplace_back(std::move(back()));
+    std::move_backward(begin() + index, end() - 2, end() - 1);
+  }
+  (*this)[index] = std::move(value);
+  return begin() + index;
+}
+
+template <typename T, typename ChunkPolicy>
+template <std::input_iterator InputIt>
+typename Deque<T, ChunkPolicy>::iterator Deque<T, ChunkPolicy>::insert(
+    const_iterator pos, InputIt first, InputIt last) {
+  if constexpr (std::forward_iterator<InputIt>) {
+    return insert_counted(pos, first, std::distance(first, last));
+  } else {
+    Deque buffer;
+    for (; first != last; ++first) {
+      buffer.emplace_back(*first);
+    }
+    return insert_counted(pos, std::make_move_iterator(buffer.begin()),
+                          buffer.size());
+  }
+}
+
+template <typename T, typename ChunkPolicy>
+template <std::input_iterator InputIt>
+void Deque<T, ChunkPolicy>::assign(InputIt first, InputIt last) {
+  Deque copy(first, last);
+  swap(copy);
+}
+
+template <typename T, typename ChunkPolicy>
+template <std::input_iterator InputIt>
+void Deque<T, ChunkPolicy>::append(InputIt first, InputIt last) {
+  if constexpr (std::forward_iterator<InputIt>) {
+    append_counted(first, std::distance(first, last));
+  } else {
+    for (; first != last; ++first) {
+      emplace_back(*first);
+    }
+  }
+}
+
+template <typename T, typename ChunkPolicy>
+template <std::input_iterator InputIt>
+void Deque<T, ChunkPolicy>::prepend(InputIt first, InputIt last) {
+  if constexpr (std::forward_iterator<InputIt>) {
+    prepend_counted(first, std::distance(first, last));
+  } else {
+    Deque buffer(first, last);
+    prepend_counted(std::make_move_iterator(buffer.begin()), buffer.size());
+  }
+}
+
+template <typename T, typename ChunkPolicy>
+template <typename Iterator>
+void Deque<T, ChunkPolicy>::append_counted(Iterator first, size_t count) {
+  reserve_back(count);
+  construct_range(ptr_first_ + size_, first, count);
+  size_ += count;
 }
 
-template <typename T>
-typename Deque<T>::iterator Deque<T>::end() {
-  int copy_ptr_arr = ptr_last_array_;
-  int copy_ptr_elem = ptr_last_elem_;
-  increment_ptr(copy_ptr_arr, copy_ptr_elem);
-  return iterator{&vector_arrays_, copy_ptr_arr, copy_ptr_elem};
+template <typename T, typename ChunkPolicy>
+template <typename Iterator>
+void Deque<T, ChunkPolicy>::prepend_counted(Iterator first, size_t count) {
+  reserve_front(count);
+  construct_range(ptr_first_ - count, first, count);
+  ptr_first_ -= count;
+  size_ += count;
 }
 
-template <typename T>
-typename Deque<T>::const_iterator Deque<T>::cend() const {
-  int copy_ptr_arr = ptr_last_array_;
-  int copy_ptr_elem = ptr_last_elem_;
-  increment_ptr(copy_ptr_arr, copy_ptr_elem);
-  return const_iterator{&vector_arrays_, copy_ptr_arr, copy_ptr_elem};
+template <typename T, typename ChunkPolicy>
+template <typename Iterator>
+typename Deque<T, ChunkPolicy>::iterator Deque<T, ChunkPolicy>::insert_counted(
+    const_iterator pos, Iterator first, size_t count) {
+  size_t index = pos - cbegin();
+  size_t after = size_ - index;
+  if (count == 0) {
+    return begin() + index;
+  }
+  if (index < after) {
+    reserve_front(count);
+    size_t new_first = ptr_first_ - count;
+    if (index >= count) {
+      construct_range(new_first, std::make_move_iterator(begin()), count);
+      ptr_first_ = new_first;
+      size_ += count;
+      std::move(begin() + 2 * count, begin() + index + count,
+                begin() + count);
+      std::copy_n(first, count, begin() + index);
+    } else {
+      Iterator middle = std::next(first, count - index);
+      construct_range(new_first, std::make_move_iterator(begin()), index);
+      try {
+        construct_range(new_first + index, first, count - index);
+      } catch (...) {
+        destroy_range(new_first, index);
+        throw;
+      }
+      ptr_first_ = new_first;
+      size_ += count;
+      std::copy_n(middle, index, begin() + count);
+    }
+  } else {
+    reserve_back(count);
+    size_t end_position = ptr_first_ + size_;
+    if (after >= count) {
+      construct_range(end_position, std::make_move_iterator(end() - count),
+                      count);
+      size_ += count;
+      std::move_backward(begin() + index, end() - 2 * count, end() - count);
+      std::copy_n(first, count, begin() + index);
+    } else {
+      Iterator middle = std::next(first, after);
+      construct_range(end_position, middle, count - after);
+      try {
+        construct_range(end_position + count - after,
+                        std::make_move_iterator(begin() + index), after);
+      } catch (...) {
+        destroy_range(end_position, count - after);
+        throw;
+      }
+      size_ += count;
+      std::copy_n(first, after, begin() + index);
+    }
+  }
+  return begin() + index;
 }
 
-template <typename T>
-void Deque<T>::insert(iterator insert_it, const T& value) {
-  if (insert_it == end()) {
-    push_back(value);
+template <typename T, typename ChunkPolicy>
+typename Deque<T, ChunkPolicy>::iterator Deque<T, ChunkPolicy>::erase(
+    const_iterator first, const_iterator last) {
+  size_t index = first - cbegin();
+  size_t count = last - first;
+  if (count == 0) {
+    return begin() + index;
+  }
+  if (index < size_ - index - count) {
+    std::move_backward(begin(), begin() + index, begin() + index + count);
+    for (size_t i = 0; i < count; ++i) {
+      pop_front();
+    }
   } else {
-    push_back(*(end() - 1));
-    iterator iterator = end() - 2;
-    while (iterator != insert_it) {
-      *iterator = *(iterator - 1);
-      --iterator;
+    std::move(begin() + index + count, end(), begin() + index);
+    for (size_t i = 0; i < count; ++i) {
+      pop_back();
     }
-    *iterator = value;
   }
+  return begin() + index;
+}
+
+template <typename T, typename ChunkPolicy>
+void Deque<T, ChunkPolicy>::swap(Deque<T, ChunkPolicy>& deque) noexcept {
+  std::swap(size_, deque.size_);
+  std::swap(capacity_, deque.capacity_);
+  std::swap(ptr_first_, deque.ptr_first_);
+  vector_arrays_.swap(deque.vector_arrays_);
+  std::swap(spare_chunks_, deque.spare_chunks_);
+  std::swap(spare_count_, deque.spare_count_);
 }
 
-template <typename T>
-void Deque<T>::erase(iterator erase_it) {
-  while (erase_it != begin()) {
-    *erase_it = *(erase_it - 1);
-    --erase_it;
+template <typename T, typename ChunkPolicy>
+void Deque<T, ChunkPolicy>::shrink_to_fit() {
+  if (size_ != 0 and capacity_ > used_arrays()) {
+    reserve(used_arrays());
+  }
+  // reserve() parks the chunks it drops in the spare list, so spares go last.
+  for (size_t i = 0; i < spare_count_; ++i) {
+    dealloc(spare_chunks_[i]);
+  }
+  spare_count_ = 0;
+  if (size_ == 0) {
+    for (size_t i = 0; i < capacity_; ++i) {
+      dealloc(vector_arrays_[i]);
+    }
+    reset();
   }
-  pop_front();
 }
 
-template <typename T>
+template <typename T, typename ChunkPolicy>
 template <bool IsConst>
-typename Deque<T>::template CommonIterator<IsConst>
-Deque<T>::CommonIterator<IsConst>::operator+(difference_type n) const {
+typename Deque<T, ChunkPolicy>::template CommonIterator<IsConst>
+Deque<T, ChunkPolicy>::CommonIterator<IsConst>::operator+(
+    difference_type n) const {
   CommonIterator<IsConst> copy = *this;
   copy += n;
   return copy;
 }
 
-template <typename T>
+template <typename T, typename ChunkPolicy>
 template <bool IsConst>
-Deque<T>::CommonIterator<IsConst>::CommonIterator(
-    ptr_to_vector_type ptr_to_vector, int ptr_array, int ptr_elem)
-    : ptr_to_vector_(ptr_to_vector),
-      ptr_array_(ptr_array),
-      ptr_elem_(ptr_elem) {}
+Deque<T, ChunkPolicy>::CommonIterator<IsConst>::CommonIterator(
+    T* const* node, size_t ptr_elem) {
+  set_node(node);
+  current_ = chunk_begin_ == nullptr ? nullptr : chunk_begin_ + ptr_elem;
+}
 
-template <typename T>
+template <typename T, typename ChunkPolicy>
 template <bool IsConst>
-typename Deque<T>::template CommonIterator<IsConst>&
-Deque<T>::CommonIterator<IsConst>::operator++() {
-  increment_ptr(ptr_array_, ptr_elem_);
+typename Deque<T, ChunkPolicy>::template CommonIterator<IsConst>&
+Deque<T, ChunkPolicy>::CommonIterator<IsConst>::operator++() {
+  if (++current_ == chunk_end_) {
+    set_node(node_ + 1);
+    current_ = chunk_begin_;
+  }
   return *this;
 }
 
-template <typename T>
+template <typename T, typename ChunkPolicy>
 template <bool IsConst>
-typename Deque<T>::template CommonIterator<IsConst>
-Deque<T>::CommonIterator<IsConst>::operator++(int) {
-  Deque<T>::CommonIterator<IsConst> copy = *this;
-  increment_ptr(ptr_array_, ptr_elem_);
+typename Deque<T, ChunkPolicy>::template CommonIterator<IsConst>
+Deque<T, ChunkPolicy>::CommonIterator<IsConst>::operator++(int) {
+  CommonIterator<IsConst> copy = *this;
+  ++*this;
   return copy;
 }
 
-template <typename T>
+template <typename T, typename ChunkPolicy>
 template <bool IsConst>
-typename Deque<T>::template CommonIterator<IsConst>&
-Deque<T>::CommonIterator<IsConst>::operator--() {
-  decrement_ptr(ptr_array_, ptr_elem_);
+typename Deque<T, ChunkPolicy>::template CommonIterator<IsConst>&
+Deque<T, ChunkPolicy>::CommonIterator<IsConst>::operator--() {
+  if (current_ == chunk_begin_) {
+    set_node(node_ - 1);
+    current_ = chunk_end_;
+  }
+  --current_;
   return *this;
 }
 
-template <typename T>
+template <typename T, typename ChunkPolicy>
 template <bool IsConst>
-typename Deque<T>::template CommonIterator<IsConst>
-Deque<T>::CommonIterator<IsConst>::operator--(int) {
-  Deque<T>::CommonIterator<IsConst> copy = *this;
-  decrement_ptr(ptr_array_, ptr_elem_);
+typename Deque<T, ChunkPolicy>::template CommonIterator<IsConst>
+Deque<T, ChunkPolicy>::CommonIterator<IsConst>::operator--(int) {
+  CommonIterator<IsConst> copy = *this;
+  --*this;
   return copy;
 }
 
-template <typename T>
+template <typename T, typename ChunkPolicy>
 template <bool IsConst>
-typename Deque<T>::template CommonIterator<IsConst>&
-Deque<T>::CommonIterator<IsConst>::operator+=(int n) {
-  int numb_it = static_cast<int>(*this);
-  numb_it += n;
-  ptr_array_ = static_cast<int>(numb_it / kSizeArray);
-  ptr_elem_ = static_cast<int>(numb_it % kSizeArray);
+typename Deque<T, ChunkPolicy>::template CommonIterator<IsConst>&
+Deque<T, ChunkPolicy>::CommonIterator<IsConst>::operator+=(
+    difference_type n) {
+  difference_type offset = n + (current_ - chunk_begin_);
+  if (offset >= 0 and offset < chunk_end_ - chunk_begin_) {
+    current_ += n;
+  } else {
+    set_node(node_ + (offset >> kChunkShift));
+    current_ = chunk_begin_ == nullptr ? nullptr
+                                       : chunk_begin_ + (offset & kChunkMask);
+  }
   return *this;
 }
 
-template <typename T>
+template <typename T, typename ChunkPolicy>
 template <bool IsConst>
-std::strong_ordering Deque<T>::CommonIterator<IsConst>::operator<=>(
+std::strong_ordering
+Deque<T, ChunkPolicy>::CommonIterator<IsConst>::operator<=>(
     const CommonIterator& iterator) const {
-  int current_iterator_numb = static_cast<int>(*this);
-  int iterator_numb = static_cast<int>(iterator);
-  if (current_iterator_numb > iterator_numb) {
-    return std::strong_ordering::greater;
-  }
-  if (current_iterator_numb == iterator_numb) {
-    return std::strong_ordering::equal;
-  }
-  return std::strong_ordering::less;
-}
\ No newline at end of file
+  return *this - iterator <=> 0;
+}
+
+static_assert(std::random_access_iterator<Deque<int>::iterator>);
+static_assert(std::random_access_iterator<Deque<int>::const_iterator>);
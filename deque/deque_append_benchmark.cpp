@@ -0,0 +1,103 @@
+// Loading 100M ints into a Deque: a push_back loop against append,
+// prepend and the range constructor from a std::vector, from another Deque
+// and from an input-only stream of values, with std::deque as a reference.
+// Needs about 1.2 GB of memory. Not part of any build; run it with
+//   g++ -std=c++20 -O2 deque/deque_append_benchmark.cpp -o append_bench
+//   ./append_bench [count]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <iterator>
+#include <numeric>
+#include <vector>
+#include "deque.h"
+
+namespace {
+
+size_t sink = 0;
+
+// Yields 0, 1, 2, ... as a single-pass range, so the deque cannot count it
+// up front.
+class CountingInput {
+ public:
+  using value_type = int;
+  using difference_type = std::ptrdiff_t;
+
+  CountingInput() = default;
+  explicit CountingInput(int value) : value_(value) {}
+  int operator*() const { return value_; }
+  CountingInput& operator++() {
+    ++value_;
+    return *this;
+  }
+  void operator++(int) { ++value_; }
+  bool operator==(const CountingInput& other) const {
+    return value_ == other.value_;
+  }
+
+ private:
+  int value_ = 0;
+};
+
+template <typename Load>
+void Measure(const char* name, size_t count, Load load) {
+  auto start = std::chrono::steady_clock::now();
+  auto loaded = load();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  if (loaded.size() != count or loaded[count / 2] != int(count / 2)) {
+    std::fprintf(stderr, "FAILED: %s loaded the wrong values\n", name);
+    std::exit(1);
+  }
+  sink += loaded.back();
+  std::printf("%-34s %9.1f ms %8.2f ns/int\n", name, elapsed.count(),
+              elapsed.count() * 1e6 / count);
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+  std::vector<int> values(count);
+  std::iota(values.begin(), values.end(), 0);
+  std::printf("%zu ints\n", count);
+
+  Measure("Deque push_back loop", count, [&] {
+    Deque<int> deque;
+    for (int value : values) {
+      deque.push_back(value);
+    }
+    return deque;
+  });
+  Measure("Deque::append(vector range)", count, [&] {
+    Deque<int> deque;
+    deque.append(values.begin(), values.end());
+    return deque;
+  });
+  Measure("Deque::prepend(vector range)", count, [&] {
+    Deque<int> deque;
+    deque.prepend(values.begin(), values.end());
+    return deque;
+  });
+  Measure("Deque(vector range)", count,
+          [&] { return Deque<int>(values.begin(), values.end()); });
+  {
+    Deque<int> source(values.begin(), values.end());
+    Measure("Deque(Deque range)", count,
+            [&] { return Deque<int>(source.begin(), source.end()); });
+  }
+  Measure("Deque(input range)", count, [&] {
+    return Deque<int>(CountingInput(0), CountingInput(int(count)));
+  });
+  Measure("std::deque push_back loop", count, [&] {
+    std::deque<int> deque;
+    for (int value : values) {
+      deque.push_back(value);
+    }
+    return deque;
+  });
+  Measure("std::deque(vector range)", count,
+          [&] { return std::deque<int>(values.begin(), values.end()); });
+  std::printf("checksum %zu\n", sink);
+}
@@ -0,0 +1,109 @@
+// Heap traffic of Deque's lazy chunks and spare list against std::deque:
+// allocations per operation for a queue in steady state, and live heap
+// bytes while a deque grows at one end, drains, and is shrunk. Live bytes
+// are tracked in operator new/delete because freed chunks stay in the
+// malloc arena and do not leave RSS. Not part of any build; run it with
+//   g++ -std=c++20 -O2 deque/deque_chunk_benchmark.cpp -o chunk_bench
+//   ./chunk_bench
+#include <malloc.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <new>
+#include "deque.h"
+
+size_t allocation_count = 0;
+size_t live_bytes = 0;
+
+void* operator new(size_t size) {
+  void* memory = std::malloc(size);
+  if (memory == nullptr) {
+    throw std::bad_alloc();
+  }
+  ++allocation_count;
+  live_bytes += malloc_usable_size(memory);
+  return memory;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void operator delete(void* memory) noexcept {
+  if (memory != nullptr) {
+    live_bytes -= malloc_usable_size(memory);
+  }
+  std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept { operator delete(memory); }
+void operator delete[](void* memory) noexcept { operator delete(memory); }
+void operator delete[](void* memory, size_t) noexcept {
+  operator delete(memory);
+}
+
+namespace {
+
+const size_t kQueueLength = 1000;
+const size_t kQueueOperations = 10000000;
+const size_t kGrowCount = 10000000;
+
+size_t sink = 0;
+
+template <typename Container>
+void SteadyQueue(const char* name) {
+  Container queue;
+  for (size_t i = 0; i < kQueueLength; ++i) {
+    queue.push_back(static_cast<int>(i));
+  }
+  size_t allocations_before = allocation_count;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kQueueOperations; ++i) {
+    queue.push_back(static_cast<int>(i));
+    sink += queue.front();
+    queue.pop_front();
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::printf("%-18s %12.6f allocs/op %8.2f ns/op\n", name,
+              double(allocation_count - allocations_before) /
+                  kQueueOperations,
+              elapsed.count() / kQueueOperations);
+}
+
+template <typename Container>
+void GrowDrainShrink(const char* name) {
+  size_t base = live_bytes;
+  size_t allocations_before = allocation_count;
+  {
+    Container deque;
+    for (size_t i = 0; i < kGrowCount; ++i) {
+      deque.push_back(static_cast<int>(i));
+    }
+    size_t full = live_bytes - base;
+    size_t allocations = allocation_count - allocations_before;
+    for (size_t i = 0; i + 1000 < kGrowCount; ++i) {
+      deque.pop_front();
+    }
+    size_t drained = live_bytes - base;
+    deque.shrink_to_fit();
+    size_t shrunk = live_bytes - base;
+    sink += deque.size();
+    std::printf("%-18s %9zu %10.1f %10.1f %10.3f\n", name, allocations,
+                full / 1e6, drained / 1e6, shrunk / 1e6);
+  }
+}
+
+}  // namespace
+
+int main() {
+  std::printf("queue of %zu ints, push_back + pop_front\n", kQueueLength);
+  SteadyQueue<Deque<int>>("Deque<int>");
+  SteadyQueue<std::deque<int>>("std::deque<int>");
+  std::printf("%zu push_back, then all but 1000 pop_front, then "
+              "shrink_to_fit\n", kGrowCount);
+  std::printf("%-18s %9s %10s %10s %10s\n", "", "allocs", "full MB",
+              "drained MB", "shrunk MB");
+  GrowDrainShrink<Deque<int>>("Deque<int>");
+  GrowDrainShrink<std::deque<int>>("std::deque<int>");
+  std::printf("checksum %zu\n", sink);
+}
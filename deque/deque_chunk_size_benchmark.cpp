@@ -0,0 +1,96 @@
+// Sweep of DequeChunkBudget byte budgets over element sizes, the data
+// behind the 4 KB default: ns per element for filling with push_back,
+// iterating, random operator[] and push_back/pop_front churn. Each run
+// holds about 64 MB of elements. Not part of any build; run it with
+//   g++ -std=c++20 -O2 deque/deque_chunk_size_benchmark.cpp -o chunk_sweep
+//   ./chunk_sweep
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "deque.h"
+
+namespace {
+
+const size_t kTotalBytes = size_t(64) << 20;
+const size_t kRandomReads = 4000000;
+
+size_t sink = 0;
+
+template <size_t Size>
+struct Element {
+  unsigned char bytes[Size];
+};
+
+double NanosecondsPer(std::chrono::steady_clock::time_point start,
+                      size_t count) {
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / count;
+}
+
+template <size_t Size, size_t Budget>
+void Run() {
+  using Chunked = Deque<Element<Size>, DequeChunkBudget<Budget>>;
+  const size_t count = kTotalBytes / Size;
+  Element<Size> value{};
+
+  auto start = std::chrono::steady_clock::now();
+  Chunked deque;
+  for (size_t i = 0; i < count; ++i) {
+    value.bytes[0] = static_cast<unsigned char>(i);
+    deque.push_back(value);
+  }
+  double fill = NanosecondsPer(start, count);
+
+  start = std::chrono::steady_clock::now();
+  for (const Element<Size>& element : deque) {
+    sink += element.bytes[0];
+  }
+  double iterate = NanosecondsPer(start, count);
+
+  std::minstd_rand random(5);
+  std::vector<size_t> indexes(kRandomReads);
+  for (size_t& index : indexes) {
+    index = random() % count;
+  }
+  start = std::chrono::steady_clock::now();
+  for (size_t index : indexes) {
+    sink += deque[index].bytes[0];
+  }
+  double random_read = NanosecondsPer(start, kRandomReads);
+
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < count; ++i) {
+    deque.push_back(value);
+    deque.pop_front();
+  }
+  double churn = NanosecondsPer(start, count);
+
+  std::printf("%6zu B %7zu B %8zu %9.2f %9.2f %9.2f %9.2f\n", Size, Budget,
+              DequeChunkBudget<Budget>::template elements<Element<Size>>(),
+              fill, iterate, random_read, churn);
+}
+
+template <size_t Size>
+void Sweep() {
+  Run<Size, 512>();
+  Run<Size, 1024>();
+  Run<Size, 4096>();
+  Run<Size, 16384>();
+  Run<Size, 65536>();
+}
+
+}  // namespace
+
+int main() {
+  std::printf("element   budget  per chunk   fill ns iterate ns  random ns"
+              "   churn ns\n");
+  Sweep<1>();
+  Sweep<8>();
+  Sweep<64>();
+  Sweep<256>();
+  Sweep<1024>();
+  std::printf("checksum %zu\n", sink);
+}
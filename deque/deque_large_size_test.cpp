@@ -0,0 +1,49 @@
+// Regression test for Deque positions and iterator distances past 2^31.
+// Needs about 2.2 GB of memory and is not part of any build; run it with
+//   g++ -std=c++20 -O2 deque/deque_large_size_test.cpp -o large && ./large
+#include <cstdio>
+#include <cstdlib>
+#include "deque.h"
+
+namespace {
+
+void Check(bool condition, const char* what) {
+  if (!condition) {
+    std::fprintf(stderr, "FAILED: %s\n", what);
+    std::exit(1);
+  }
+}
+
+char Value(size_t index) { return static_cast<char>(index * 7); }
+
+}  // namespace
+
+int main() {
+  const size_t kBackCount = (size_t(1) << 31) + 1000;
+  const size_t kFrontCount = 500;
+  Deque<char> deque;
+  for (size_t i = 0; i < kBackCount; ++i) {
+    deque.push_back(Value(i));
+  }
+  for (size_t i = 0; i < kFrontCount; ++i) {
+    deque.push_front('x');
+  }
+  size_t total = kBackCount + kFrontCount;
+  Check(deque.size() == total, "size() past 2^31");
+  Check(deque.end() - deque.begin() == static_cast<std::ptrdiff_t>(total),
+        "iterator distance past 2^31");
+  for (size_t i = (size_t(1) << 31) - 10; i < kBackCount; ++i) {
+    Check(deque[i + kFrontCount] == Value(i), "operator[] across 2^31");
+  }
+  auto last = deque.begin() + static_cast<std::ptrdiff_t>(total - 1);
+  Check(*last == Value(kBackCount - 1), "iterator advance past 2^31");
+  Check(last - static_cast<std::ptrdiff_t>(total - 1) == deque.begin(),
+        "iterator retreat past 2^31");
+  for (size_t i = 0; i < kBackCount; ++i) {
+    deque.pop_front();
+  }
+  Check(deque.size() == kFrontCount, "pop_front past 2^31");
+  Check(deque.front() == Value(kBackCount - kFrontCount),
+        "front() after draining");
+  std::puts("OK");
+}
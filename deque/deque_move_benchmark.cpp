@@ -0,0 +1,86 @@
+// Copy against move for Deque with std::string- and std::vector-sized
+// elements (pushes, whole-deque construction), plus the memcpy copy path
+// for trivially copyable elements, with std::deque as a reference. Not part
+// of any build; run it with
+//   g++ -std=c++20 -O2 deque/deque_move_benchmark.cpp -o move_bench
+//   ./move_bench
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+#include "deque.h"
+
+namespace {
+
+const size_t kCount = 1000000;
+
+size_t sink = 0;
+
+double Milliseconds(std::chrono::steady_clock::time_point start) {
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+template <typename Container, typename T>
+void Pushes(const char* name, const T& value) {
+  std::vector<T> sources(kCount, value);
+  auto start = std::chrono::steady_clock::now();
+  Container copied;
+  for (const T& source : sources) {
+    copied.push_back(source);
+  }
+  double copy = Milliseconds(start);
+  start = std::chrono::steady_clock::now();
+  Container moved;
+  for (T& source : sources) {
+    moved.push_back(std::move(source));
+  }
+  double move = Milliseconds(start);
+
+  start = std::chrono::steady_clock::now();
+  Container copy_constructed(copied);
+  double copy_construct = Milliseconds(start);
+  start = std::chrono::steady_clock::now();
+  Container move_constructed(std::move(copied));
+  double move_construct = Milliseconds(start);
+  sink += copy_constructed.size() + move_constructed.size() + moved.size();
+  std::printf("%-26s %9.1f %9.1f %10.1f %10.4f\n", name, copy, move,
+              copy_construct, move_construct);
+}
+
+template <typename Container>
+void TrivialCopy(const char* name) {
+  Container source;
+  for (size_t i = 0; i < 10 * kCount; ++i) {
+    source.push_back(static_cast<int>(i));
+  }
+  auto start = std::chrono::steady_clock::now();
+  Container copy(source);
+  double elapsed = Milliseconds(start);
+  sink += copy[kCount];
+  std::printf("%-26s %9.1f\n", name, elapsed);
+}
+
+}  // namespace
+
+int main() {
+  std::string text(64, 'x');
+  std::vector<int> numbers(16, 7);
+  // Grow the heap first so that the first row is not charged for it.
+  std::vector<std::string> warm_up(4 * kCount, text);
+  warm_up = {};
+  std::printf("%zu elements, ms   push copy push move copy ctor   move ctor\n",
+              kCount);
+  Pushes<Deque<std::string>>("Deque<string(64)>", text);
+  Pushes<std::deque<std::string>>("std::deque<string(64)>", text);
+  Pushes<Deque<std::vector<int>>>("Deque<vector<int>(16)>", numbers);
+  Pushes<std::deque<std::vector<int>>>("std::deque<vector<int>(16)>", numbers);
+  std::printf("copy of %zu ints, ms\n", 10 * kCount);
+  TrivialCopy<Deque<int>>("Deque<int>");
+  TrivialCopy<std::deque<int>>("std::deque<int>");
+  std::printf("checksum %zu\n", sink);
+}
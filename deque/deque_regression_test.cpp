@@ -0,0 +1,97 @@
+// Regression tests for Deque. Not part of any build; run it with
+//   g++ -std=c++20 -fsanitize=address,undefined
+//       deque/deque_regression_test.cpp -o deque_test && ./deque_test
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "deque.h"
+
+// Deque allocates its chunks, and only its chunks, with new[].
+size_t live_array_allocations = 0;
+
+void* operator new[](size_t size) {
+  ++live_array_allocations;
+  if (void* memory = std::malloc(size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete[](void* memory) noexcept {
+  if (memory != nullptr) {
+    --live_array_allocations;
+  }
+  std::free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept {
+  operator delete[](memory);
+}
+
+namespace {
+
+void Check(bool condition, const char* what) {
+  if (!condition) {
+    std::fprintf(stderr, "FAILED: %s\n", what);
+    std::exit(1);
+  }
+}
+
+// An empty copy keeps a non-aligned ptr_first_ but allocates no chunks, so
+// prepend must allocate the chunk that holds ptr_first_ - 1 itself.
+void TestPrependIntoEmptyCopy() {
+  Deque<int> source;
+  source.push_front(1);
+  source.pop_back();
+  std::vector<int> values{7, 8, 9};
+  Deque<int> copy(source);
+  copy.prepend(values.begin(), values.end());
+  Check(copy.size() == 3 and copy[0] == 7 and copy[2] == 9,
+        "prepend into an empty copy");
+  Deque<int> assigned;
+  assigned = source;
+  assigned.prepend(values.begin(), values.end());
+  Check(assigned.size() == 3 and assigned[1] == 8,
+        "prepend into an empty copy-assigned deque");
+  Deque<int> inserted(source);
+  inserted.insert(inserted.begin(), values.begin(), values.end());
+  Check(inserted.size() == 3 and inserted.back() == 9,
+        "insert at the front of an empty copy");
+}
+
+struct ThrowsOnCopy {
+  static int copies_left;
+  int value;
+  explicit ThrowsOnCopy(int value) : value(value) {}
+  ThrowsOnCopy(const ThrowsOnCopy& other) : value(other.value) {
+    if (--copies_left < 0) {
+      throw 1;
+    }
+  }
+};
+int ThrowsOnCopy::copies_left = 1000;
+
+// A prepend that throws leaves its reserved chunks in front of the data;
+// shrink_to_fit must free them even though reserve() parks them as spares.
+void TestShrinkToFitFreesEverythingIdle() {
+  Deque<ThrowsOnCopy, DequeChunkBudget<64, 2>> deque;
+  deque.emplace_back(0);
+  std::vector<ThrowsOnCopy> values(100, ThrowsOnCopy(1));
+  ThrowsOnCopy::copies_left = 90;
+  try {
+    deque.prepend(values.begin(), values.end());
+  } catch (int) {
+  }
+  Check(deque.size() == 1, "failed prepend leaves the deque unchanged");
+  deque.shrink_to_fit();
+  Check(live_array_allocations == 1, "shrink_to_fit keeps only used chunks");
+}
+
+}  // namespace
+
+int main() {
+  TestPrependIntoEmptyCopy();
+  TestShrinkToFitFreesEverythingIdle();
+  std::puts("OK");
+}
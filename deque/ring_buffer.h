@@ -0,0 +1,225 @@
+#pragma once
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <utility>
+
+enum class RingBufferFull { kOverwriteOldest, kReject };
+
+// Fixed-capacity double-ended queue for "last N" windows. Storage is
+// allocated once, in the constructor, and rounded up to a power of two so
+// that indexing is a mask instead of a division; nothing is allocated after
+// that. The contents are at most two contiguous runs, see spans().
+template <typename T, RingBufferFull OnFull = RingBufferFull::kOverwriteOldest>
+class RingBuffer {
+ private:
+  T* data_ = nullptr;
+  size_t mask_ = 0;
+  size_t capacity_ = 0;
+  size_t head_ = 0;
+  size_t size_ = 0;
+
+  size_t storage_size() const { return capacity_ == 0 ? 0 : mask_ + 1; }
+  T* slot(size_t index) const { return data_ + ((head_ + index) & mask_); }
+  bool accepts_push() const;
+
+ public:
+  explicit RingBuffer(size_t capacity);
+  RingBuffer(const RingBuffer& ring);
+  RingBuffer(RingBuffer&& ring) noexcept;
+  RingBuffer& operator=(const RingBuffer& ring);
+  RingBuffer& operator=(RingBuffer&& ring) noexcept;
+  ~RingBuffer();
+
+  [[nodiscard]] size_t size() const { return size_; }
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+  [[nodiscard]] bool empty() const { return size_ == 0; }
+  [[nodiscard]] bool full() const { return size_ == capacity_; }
+
+  T& operator[](size_t index) { return *slot(index); }
+  const T& operator[](size_t index) const { return *slot(index); }
+  T& at(size_t index);
+  [[nodiscard]] const T& at(size_t index) const {
+    return const_cast<RingBuffer&>(*this).at(index);
+  }
+  T& front() { return *slot(0); }
+  const T& front() const { return *slot(0); }
+  T& back() { return *slot(size_ - 1); }
+  const T& back() const { return *slot(size_ - 1); }
+
+  // With kReject these return false and leave the buffer untouched when it
+  // is full; with kOverwriteOldest they drop the opposite end, after the new
+  // element is built, so the arguments may refer to the buffer itself.
+  bool push_back(const T& value) { return emplace_back(value); }
+  bool push_back(T&& value) { return emplace_back(std::move(value)); }
+  template <typename... Args>
+  bool emplace_back(Args&&... args);
+  bool push_front(const T& value) { return emplace_front(value); }
+  bool push_front(T&& value) { return emplace_front(std::move(value)); }
+  template <typename... Args>
+  bool emplace_front(Args&&... args);
+  void pop_back();
+  void pop_front();
+  void clear();
+
+  // The contents in order: spans().first followed by spans().second.
+  std::pair<std::span<T>, std::span<T>> spans();
+  std::pair<std::span<const T>, std::span<const T>> spans() const;
+
+  void swap(RingBuffer& ring) noexcept;
+};
+
+template <typename T, RingBufferFull OnFull>
+RingBuffer<T, OnFull>::RingBuffer(size_t capacity)
+    : mask_(std::bit_ceil(std::max<size_t>(capacity, 1)) - 1),
+      capacity_(capacity) {
+  if (capacity_ != 0) {
+    data_ = std::allocator<T>().allocate(storage_size());
+  }
+}
+
+template <typename T, RingBufferFull OnFull>
+RingBuffer<T, OnFull>::RingBuffer(const RingBuffer& ring)
+    : RingBuffer(ring.capacity_) {
+  auto [first, second] = ring.spans();
+  std::uninitialized_copy(first.begin(), first.end(), data_);
+  try {
+    std::uninitialized_copy(second.begin(), second.end(),
+                            data_ + first.size());
+  } catch (...) {
+    std::destroy(data_, data_ + first.size());
+    throw;
+  }
+  size_ = ring.size_;
+}
+
+template <typename T, RingBufferFull OnFull>
+RingBuffer<T, OnFull>::RingBuffer(RingBuffer&& ring) noexcept
+    : data_(std::exchange(ring.data_, nullptr)),
+      mask_(std::exchange(ring.mask_, 0)),
+      capacity_(std::exchange(ring.capacity_, 0)),
+      head_(std::exchange(ring.head_, 0)),
+      size_(std::exchange(ring.size_, 0)) {}
+
+template <typename T, RingBufferFull OnFull>
+RingBuffer<T, OnFull>& RingBuffer<T, OnFull>::operator=(
+    const RingBuffer& ring) {
+  if (this != &ring) {
+    RingBuffer copy(ring);
+    swap(copy);
+  }
+  return *this;
+}
+
+template <typename T, RingBufferFull OnFull>
+RingBuffer<T, OnFull>& RingBuffer<T, OnFull>::operator=(
+    RingBuffer&& ring) noexcept {
+  RingBuffer moved(std::move(ring));
+  swap(moved);
+  return *this;
+}
+
+template <typename T, RingBufferFull OnFull>
+RingBuffer<T, OnFull>::~RingBuffer() {
+  clear();
+  if (data_ != nullptr) {
+    std::allocator<T>().deallocate(data_, storage_size());
+  }
+}
+
+template <typename T, RingBufferFull OnFull>
+T& RingBuffer<T, OnFull>::at(size_t index) {
+  if (index >= size_) {
+    throw std::out_of_range("RingBuffer index out of range");
+  }
+  return *slot(index);
+}
+
+template <typename T, RingBufferFull OnFull>
+bool RingBuffer<T, OnFull>::accepts_push() const {
+  return size_ < capacity_ or
+         (OnFull == RingBufferFull::kOverwriteOldest and capacity_ != 0);
+}
+
+template <typename T, RingBufferFull OnFull>
+template <typename... Args>
+bool RingBuffer<T, OnFull>::emplace_back(Args&&... args) {
+  if (!accepts_push()) {
+    return false;
+  }
+  if (full()) {
+    T value(std::forward<Args>(args)...);
+    pop_front();
+    new (slot(size_)) T(std::move(value));
+  } else {
+    new (slot(size_)) T(std::forward<Args>(args)...);
+  }
+  ++size_;
+  return true;
+}
+
+template <typename T, RingBufferFull OnFull>
+template <typename... Args>
+bool RingBuffer<T, OnFull>::emplace_front(Args&&... args) {
+  if (!accepts_push()) {
+    return false;
+  }
+  size_t new_head = (head_ - 1) & mask_;
+  if (full()) {
+    T value(std::forward<Args>(args)...);
+    pop_back();
+    new (data_ + new_head) T(std::move(value));
+  } else {
+    new (data_ + new_head) T(std::forward<Args>(args)...);
+  }
+  head_ = new_head;
+  ++size_;
+  return true;
+}
+
+template <typename T, RingBufferFull OnFull>
+void RingBuffer<T, OnFull>::pop_back() {
+  slot(size_ - 1)->~T();
+  --size_;
+}
+
+template <typename T, RingBufferFull OnFull>
+void RingBuffer<T, OnFull>::pop_front() {
+  slot(0)->~T();
+  head_ = (head_ + 1) & mask_;
+  --size_;
+}
+
+template <typename T, RingBufferFull OnFull>
+void RingBuffer<T, OnFull>::clear() {
+  auto [first, second] = spans();
+  std::destroy(first.begin(), first.end());
+  std::destroy(second.begin(), second.end());
+  head_ = 0;
+  size_ = 0;
+}
+
+template <typename T, RingBufferFull OnFull>
+std::pair<std::span<T>, std::span<T>> RingBuffer<T, OnFull>::spans() {
+  size_t first = std::min(size_, storage_size() - head_);
+  return {std::span<T>(data_ + head_, first),
+          std::span<T>(data_, size_ - first)};
+}
+
+template <typename T, RingBufferFull OnFull>
+std::pair<std::span<const T>, std::span<const T>>
+RingBuffer<T, OnFull>::spans() const {
+  auto [first, second] = const_cast<RingBuffer&>(*this).spans();
+  return {first, second};
+}
+
+template <typename T, RingBufferFull OnFull>
+void RingBuffer<T, OnFull>::swap(RingBuffer& ring) noexcept {
+  std::swap(data_, ring.data_);
+  std::swap(mask_, ring.mask_);
+  std::swap(capacity_, ring.capacity_);
+  std::swap(head_, ring.head_);
+  std::swap(size_, ring.size_);
+}
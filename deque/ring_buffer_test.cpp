@@ -0,0 +1,67 @@
+// Tests for RingBuffer. Not part of any build; run it with
+//   g++ -std=c++20 -fsanitize=address deque/ring_buffer_test.cpp -o ring &&
+//   ./ring
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "ring_buffer.h"
+
+namespace {
+
+void Check(bool condition, const char* what) {
+  if (!condition) {
+    std::fprintf(stderr, "FAILED: %s\n", what);
+    std::exit(1);
+  }
+}
+
+std::string Long(char symbol) { return std::string(40, symbol); }
+
+void TestPushOwnElementWhenFull() {
+  RingBuffer<std::string> ring(3);
+  ring.push_back(Long('a'));
+  ring.push_back(Long('b'));
+  ring.push_back(Long('c'));
+  ring.push_back(ring.front());
+  Check(ring.size() == 3, "push_back(front()) keeps the size");
+  Check(ring[0] == Long('b') and ring[2] == Long('a'),
+        "push_back(front()) reads the element before evicting it");
+  ring.push_front(ring.back());
+  Check(ring[0] == Long('a') and ring[1] == Long('b') and
+            ring[2] == Long('c'),
+        "push_front(back()) reads the element before evicting it");
+  ring.emplace_back(ring[0], 0, 3);
+  Check(ring.back() == "aaa", "emplace_back from an element being evicted");
+}
+
+void TestReject() {
+  RingBuffer<int, RingBufferFull::kReject> ring(2);
+  Check(ring.push_back(1) and ring.push_back(2), "push below capacity");
+  Check(!ring.push_back(3) and !ring.push_front(0), "push when full");
+  Check(ring.front() == 1 and ring.back() == 2, "rejected push is a no-op");
+}
+
+void TestSpans() {
+  RingBuffer<int> ring(5);
+  for (int i = 0; i < 12; ++i) {
+    ring.push_back(i);
+  }
+  auto [first, second] = ring.spans();
+  Check(first.size() + second.size() == 5, "spans cover the contents");
+  int expected = 7;
+  for (int value : first) {
+    Check(value == expected++, "first span is in order");
+  }
+  for (int value : second) {
+    Check(value == expected++, "second span continues the first");
+  }
+}
+
+}  // namespace
+
+int main() {
+  TestPushOwnElementWhenFull();
+  TestReject();
+  TestSpans();
+  std::puts("OK");
+}
@@ -0,0 +1,242 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+
+#include "deque.h"
+
+// Unbounded queue for exactly one producer thread (push_*) and one consumer
+// thread (try_pop_front, pop_bulk). Elements live in the same power-of-two
+// chunks as Deque, linked into a list instead of a map so that neither side
+// ever has to relocate it. Drained chunks go back to the producer through a
+// lock-free stack, so a queue in steady state does not allocate.
+template <typename T, typename ChunkPolicy = DequeChunkBudget<>>
+class SpscDeque {
+ private:
+  static constexpr size_t kSizeArray = ChunkPolicy::template elements<T>();
+  static_assert(std::has_single_bit(kSizeArray),
+                "SpscDeque chunk size must be a power of two");
+  static constexpr size_t kChunkMask = kSizeArray - 1;
+  static const size_t kMaxSpareChunks = 4;
+  static const size_t kCacheLine = 64;
+
+  struct Chunk {
+    Chunk* next = nullptr;
+    alignas(T) unsigned char storage[kSizeArray * sizeof(T)];
+    T* slot(size_t position) {
+      return std::launder(reinterpret_cast<T*>(storage)) +
+             (position & kChunkMask);
+    }
+  };
+
+  // Producer side.
+  alignas(kCacheLine) std::atomic<size_t> tail_{0};
+  Chunk* tail_chunk_;
+  Chunk* spare_chunks_ = nullptr;
+
+  // Consumer side.
+  alignas(kCacheLine) std::atomic<size_t> head_{0};
+  size_t tail_cache_ = 0;
+  Chunk* head_chunk_;
+
+  // Chunks on their way from the consumer back to the producer.
+  alignas(kCacheLine) std::atomic<Chunk*> recycled_chunks_{nullptr};
+  std::atomic<size_t> spare_count_{0};
+
+  Chunk* take_chunk();
+  void recycle_chunk(Chunk* chunk);
+  T* producer_slot(size_t position);
+  T* consumer_slot(size_t position) const;
+  void consumed(size_t position);
+  size_t available(size_t head);
+  static void delete_chain(Chunk* chunk);
+
+ public:
+  SpscDeque() : tail_chunk_(new Chunk), head_chunk_(tail_chunk_) {}
+  SpscDeque(const SpscDeque&) = delete;
+  SpscDeque& operator=(const SpscDeque&) = delete;
+  ~SpscDeque();
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+  template <typename... Args>
+  void emplace_back(Args&&... args);
+  template <std::input_iterator InputIt>
+  void push_bulk(InputIt first, InputIt last);
+
+  bool try_pop_front(T& value);
+  template <typename OutputIt>
+  size_t pop_bulk(OutputIt out, size_t max_count);
+
+  // Exact only when called from one of the two sides while the other is idle.
+  [[nodiscard]] size_t size_approx() const {
+    size_t head = head_.load(std::memory_order_acquire);
+    return tail_.load(std::memory_order_acquire) - head;
+  }
+  [[nodiscard]] bool empty_approx() const { return size_approx() == 0; }
+};
+
+template <typename T, typename ChunkPolicy>
+SpscDeque<T, ChunkPolicy>::~SpscDeque() {
+  size_t tail = tail_.load(std::memory_order_acquire);
+  for (size_t head = head_.load(std::memory_order_relaxed); head != tail;
+       ++head) {
+    consumer_slot(head)->~T();
+    consumed(head);
+  }
+  delete_chain(head_chunk_);
+  delete_chain(spare_chunks_);
+  delete_chain(recycled_chunks_.load(std::memory_order_acquire));
+}
+
+template <typename T, typename ChunkPolicy>
+void SpscDeque<T, ChunkPolicy>::delete_chain(Chunk* chunk) {
+  while (chunk != nullptr) {
+    delete std::exchange(chunk, chunk->next);
+  }
+}
+
+template <typename T, typename ChunkPolicy>
+typename SpscDeque<T, ChunkPolicy>::Chunk*
+SpscDeque<T, ChunkPolicy>::take_chunk() {
+  if (spare_chunks_ == nullptr) {
+    spare_chunks_ =
+        recycled_chunks_.exchange(nullptr, std::memory_order_acquire);
+  }
+  if (spare_chunks_ == nullptr) {
+    return new Chunk;
+  }
+  Chunk* chunk = std::exchange(spare_chunks_, spare_chunks_->next);
+  spare_count_.fetch_sub(1, std::memory_order_relaxed);
+  chunk->next = nullptr;
+  return chunk;
+}
+
+template <typename T, typename ChunkPolicy>
+void SpscDeque<T, ChunkPolicy>::recycle_chunk(Chunk* chunk) {
+  if (spare_count_.load(std::memory_order_relaxed) >= kMaxSpareChunks) {
+    delete chunk;
+    return;
+  }
+  spare_count_.fetch_add(1, std::memory_order_relaxed);
+  chunk->next = recycled_chunks_.load(std::memory_order_relaxed);
+  while (!recycled_chunks_.compare_exchange_weak(chunk->next, chunk,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+  }
+}
+
+// Both sides cross a chunk boundary lazily: tail_chunk_ (head_chunk_) stays
+// on the chunk of position - 1 until the element at position has actually
+// been constructed (moved out), so a throwing T leaves the cursors intact.
+// The next chunk is linked before the element in it is published, which is
+// what lets the consumer follow next without a lock.
+template <typename T, typename ChunkPolicy>
+T* SpscDeque<T, ChunkPolicy>::producer_slot(size_t position) {
+  if ((position & kChunkMask) != 0 or position == 0) {
+    return tail_chunk_->slot(position);
+  }
+  if (tail_chunk_->next == nullptr) {
+    tail_chunk_->next = take_chunk();
+  }
+  return tail_chunk_->next->slot(position);
+}
+
+template <typename T, typename ChunkPolicy>
+T* SpscDeque<T, ChunkPolicy>::consumer_slot(size_t position) const {
+  if ((position & kChunkMask) != 0 or position == 0) {
+    return head_chunk_->slot(position);
+  }
+  return head_chunk_->next->slot(position);
+}
+
+template <typename T, typename ChunkPolicy>
+void SpscDeque<T, ChunkPolicy>::consumed(size_t position) {
+  if ((position & kChunkMask) == 0 and position != 0) {
+    recycle_chunk(std::exchange(head_chunk_, head_chunk_->next));
+  }
+}
+
+template <typename T, typename ChunkPolicy>
+size_t SpscDeque<T, ChunkPolicy>::available(size_t head) {
+  if (tail_cache_ == head) {
+    tail_cache_ = tail_.load(std::memory_order_acquire);
+  }
+  return tail_cache_ - head;
+}
+
+template <typename T, typename ChunkPolicy>
+template <typename... Args>
+void SpscDeque<T, ChunkPolicy>::emplace_back(Args&&... args) {
+  size_t tail = tail_.load(std::memory_order_relaxed);
+  new (producer_slot(tail)) T(std::forward<Args>(args)...);
+  if ((tail & kChunkMask) == 0 and tail != 0) {
+    tail_chunk_ = tail_chunk_->next;
+  }
+  tail_.store(tail + 1, std::memory_order_release);
+}
+
+// Publishes once per chunk rather than once per element. If a constructor
+// throws, the elements built before it are still pushed.
+template <typename T, typename ChunkPolicy>
+template <std::input_iterator InputIt>
+void SpscDeque<T, ChunkPolicy>::push_bulk(InputIt first, InputIt last) {
+  size_t tail = tail_.load(std::memory_order_relaxed);
+  try {
+    for (; first != last; ++first) {
+      new (producer_slot(tail)) T(*first);
+      if ((tail & kChunkMask) == 0 and tail != 0) {
+        tail_.store(tail, std::memory_order_release);
+        tail_chunk_ = tail_chunk_->next;
+      }
+      ++tail;
+    }
+  } catch (...) {
+    tail_.store(tail, std::memory_order_release);
+    throw;
+  }
+  tail_.store(tail, std::memory_order_release);
+}
+
+template <typename T, typename ChunkPolicy>
+bool SpscDeque<T, ChunkPolicy>::try_pop_front(T& value) {
+  size_t head = head_.load(std::memory_order_relaxed);
+  if (available(head) == 0) {
+    return false;
+  }
+  T* slot = consumer_slot(head);
+  value = std::move(*slot);
+  slot->~T();
+  consumed(head);
+  head_.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+template <typename T, typename ChunkPolicy>
+template <typename OutputIt>
+size_t SpscDeque<T, ChunkPolicy>::pop_bulk(OutputIt out, size_t max_count) {
+  size_t first = head_.load(std::memory_order_relaxed);
+  if (tail_cache_ - first < max_count) {
+    tail_cache_ = tail_.load(std::memory_order_acquire);
+  }
+  size_t last = first + std::min(max_count, tail_cache_ - first);
+  size_t head = first;
+  try {
+    for (; head != last; ++head) {
+      T* slot = consumer_slot(head);
+      *out = std::move(*slot);
+      ++out;
+      slot->~T();
+      consumed(head);
+    }
+  } catch (...) {
+    head_.store(head, std::memory_order_release);
+    throw;
+  }
+  head_.store(head, std::memory_order_release);
+  return head - first;
+}
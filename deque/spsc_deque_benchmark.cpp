@@ -0,0 +1,121 @@
+// Throughput and latency of SpscDeque against a Deque guarded by a mutex, one
+// producer and one consumer thread. Each element carries the time it was
+// pushed, so latency is push-to-pop. Not part of any build; run it with
+//   g++ -std=c++20 -O2 -pthread deque/spsc_deque_benchmark.cpp -o spsc_bench
+//   ./spsc_bench [element count]
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "spsc_deque.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+int64_t Now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             Clock::now().time_since_epoch())
+      .count();
+}
+
+class LockedDeque {
+ private:
+  std::mutex mutex_;
+  Deque<int64_t> deque_;
+
+ public:
+  void push_back(int64_t value) {
+    std::lock_guard lock(mutex_);
+    deque_.push_back(value);
+  }
+  bool try_pop_front(int64_t& value) {
+    std::lock_guard lock(mutex_);
+    if (deque_.size() == 0) {
+      return false;
+    }
+    value = deque_.front();
+    deque_.pop_front();
+    return true;
+  }
+};
+
+struct Result {
+  double seconds;
+  int64_t p50;
+  int64_t p99;
+};
+
+template <typename Queue>
+Result Run(size_t count) {
+  Queue queue;
+  std::vector<int64_t> latencies;
+  latencies.reserve(count);
+  auto start = Clock::now();
+  std::thread consumer([&] {
+    int64_t pushed_at;
+    while (latencies.size() < count) {
+      if (queue.try_pop_front(pushed_at)) {
+        latencies.push_back(Now() - pushed_at);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+  });
+  for (size_t i = 0; i < count; ++i) {
+    queue.push_back(Now());
+  }
+  consumer.join();
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+  std::sort(latencies.begin(), latencies.end());
+  return {elapsed.count(), latencies[count / 2], latencies[count * 99 / 100]};
+}
+
+// Bulk transfer only: batches of kBatch on both sides, no timestamps.
+double RunBulk(size_t count) {
+  const size_t kBatch = 256;
+  SpscDeque<int64_t> queue;
+  auto start = Clock::now();
+  std::thread consumer([&] {
+    std::vector<int64_t> batch(kBatch);
+    size_t received = 0;
+    while (received < count) {
+      size_t popped = queue.pop_bulk(batch.begin(), kBatch);
+      if (popped == 0) {
+        std::this_thread::yield();
+      }
+      received += popped;
+    }
+  });
+  std::vector<int64_t> batch(kBatch);
+  for (size_t sent = 0; sent < count; sent += kBatch) {
+    queue.push_bulk(batch.begin(),
+                    batch.begin() + std::min(kBatch, count - sent));
+  }
+  consumer.join();
+  std::chrono::duration<double> elapsed = Clock::now() - start;
+  return elapsed.count();
+}
+
+void Report(const char* name, size_t count, const Result& result) {
+  std::printf("%-22s %8.2f Mops/s   p50 %9lld ns   p99 %9lld ns\n", name,
+              count / result.seconds / 1e6,
+              static_cast<long long>(result.p50),
+              static_cast<long long>(result.p99));
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+  std::printf("%zu elements, %u hardware threads\n", count,
+              std::thread::hardware_concurrency());
+  Report("mutex + Deque", count, Run<LockedDeque>(count));
+  Report("SpscDeque", count, Run<SpscDeque<int64_t>>(count));
+  std::printf("%-22s %8.2f Mops/s\n", "SpscDeque bulk 256",
+              count / RunBulk(count) / 1e6);
+}
@@ -0,0 +1,169 @@
+#pragma once
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "deque.h"
+
+// Chase-Lev work-stealing deque. The owning thread pushes and pops at the
+// back; any number of thieves steal from the front. Storage is a ring of
+// Deque-style chunks: growing doubles the ring and reuses every existing
+// chunk in it, so elements are never copied and thieves still holding the
+// previous ring keep reading the same chunks. Old rings are kept until
+// destruction because a thief may be in the middle of reading one.
+template <typename T, typename ChunkPolicy = DequeChunkBudget<>>
+class WorkStealingDeque {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Thieves read elements speculatively, so T must be "
+                "trivially copyable");
+  static_assert(std::atomic<T>::is_always_lock_free,
+                "Slots are std::atomic<T>; a lock-based one would make "
+                "push_back and try_steal block");
+
+ private:
+  static constexpr size_t kSizeArray = ChunkPolicy::template elements<T>();
+  static_assert(std::has_single_bit(kSizeArray),
+                "WorkStealingDeque chunk size must be a power of two");
+  static constexpr int kChunkShift = std::countr_zero(kSizeArray);
+  static constexpr size_t kChunkMask = kSizeArray - 1;
+  static const size_t kCacheLine = 64;
+
+  struct Chunk {
+    std::atomic<T> slots[kSizeArray];
+  };
+
+  struct Ring {
+    size_t mask;
+    std::unique_ptr<Chunk*[]> chunks;
+    explicit Ring(size_t chunk_count)
+        : mask(chunk_count - 1), chunks(new Chunk*[chunk_count]) {}
+    std::atomic<T>& slot(std::ptrdiff_t position) const {
+      auto linear = static_cast<size_t>(position);
+      return chunks[(linear >> kChunkShift) & mask]->slots[linear & kChunkMask];
+    }
+  };
+
+  alignas(kCacheLine) std::atomic<std::ptrdiff_t> top_{0};
+  alignas(kCacheLine) std::atomic<std::ptrdiff_t> bottom_{0};
+  std::atomic<Ring*> ring_;
+  std::vector<std::unique_ptr<Ring>> rings_;
+
+  Ring* grow(Ring* ring, std::ptrdiff_t top);
+
+ public:
+  WorkStealingDeque();
+  WorkStealingDeque(const WorkStealingDeque&) = delete;
+  WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+  ~WorkStealingDeque();
+
+  // Owner thread only.
+  void push_back(T value);
+  bool try_pop_back(T& value);
+
+  // Any thread. Fails when the deque is empty or another thread won the race
+  // for the front element.
+  bool try_steal(T& value);
+
+  [[nodiscard]] size_t size_approx() const {
+    std::ptrdiff_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::ptrdiff_t top = top_.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+  }
+};
+
+template <typename T, typename ChunkPolicy>
+WorkStealingDeque<T, ChunkPolicy>::WorkStealingDeque() {
+  auto ring = std::make_unique<Ring>(1);
+  ring->chunks[0] = new Chunk;
+  ring_.store(ring.get(), std::memory_order_relaxed);
+  rings_.push_back(std::move(ring));
+}
+
+template <typename T, typename ChunkPolicy>
+WorkStealingDeque<T, ChunkPolicy>::~WorkStealingDeque() {
+  Ring* ring = ring_.load(std::memory_order_relaxed);
+  for (size_t i = 0; i <= ring->mask; ++i) {
+    delete ring->chunks[i];
+  }
+}
+
+// The live blocks [top, bottom) occupy at most mask + 1 consecutive chunk
+// indices, so the old chunks are laid out from the top block on and each
+// keeps serving the same positions; the second half gets fresh chunks.
+template <typename T, typename ChunkPolicy>
+typename WorkStealingDeque<T, ChunkPolicy>::Ring*
+WorkStealingDeque<T, ChunkPolicy>::grow(Ring* ring, std::ptrdiff_t top) {
+  size_t old_count = ring->mask + 1;
+  auto bigger = std::make_unique<Ring>(2 * old_count);
+  size_t first_block = static_cast<size_t>(top) >> kChunkShift;
+  for (size_t i = 0; i < old_count; ++i) {
+    size_t block = first_block + i;
+    bigger->chunks[block & bigger->mask] = ring->chunks[block & ring->mask];
+  }
+  for (size_t i = old_count; i < 2 * old_count; ++i) {
+    size_t block = first_block + i;
+    bigger->chunks[block & bigger->mask] = new Chunk;
+  }
+  Ring* result = bigger.get();
+  rings_.push_back(std::move(bigger));
+  ring_.store(result, std::memory_order_release);
+  return result;
+}
+
+template <typename T, typename ChunkPolicy>
+void WorkStealingDeque<T, ChunkPolicy>::push_back(T value) {
+  std::ptrdiff_t bottom = bottom_.load(std::memory_order_relaxed);
+  std::ptrdiff_t top = top_.load(std::memory_order_acquire);
+  Ring* ring = ring_.load(std::memory_order_relaxed);
+  size_t blocks = (static_cast<size_t>(bottom) >> kChunkShift) -
+                  (static_cast<size_t>(top) >> kChunkShift);
+  if (blocks > ring->mask) {
+    ring = grow(ring, top);
+  }
+  ring->slot(bottom).store(value, std::memory_order_relaxed);
+  bottom_.store(bottom + 1, std::memory_order_release);
+}
+
+// Both sides use seq_cst on bottom_ and top_ in place of the stand-alone
+// fences of the original algorithm: the owner's store to bottom_ must be
+// ordered before its load of top_ against a concurrent thief.
+template <typename T, typename ChunkPolicy>
+bool WorkStealingDeque<T, ChunkPolicy>::try_pop_back(T& value) {
+  std::ptrdiff_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+  Ring* ring = ring_.load(std::memory_order_relaxed);
+  bottom_.store(bottom, std::memory_order_seq_cst);
+  std::ptrdiff_t top = top_.load(std::memory_order_seq_cst);
+  if (top > bottom) {
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+    return false;
+  }
+  value = ring->slot(bottom).load(std::memory_order_relaxed);
+  if (top < bottom) {
+    return true;
+  }
+  bool won = top_.compare_exchange_strong(top, top + 1,
+                                          std::memory_order_seq_cst,
+                                          std::memory_order_relaxed);
+  bottom_.store(bottom + 1, std::memory_order_relaxed);
+  return won;
+}
+
+template <typename T, typename ChunkPolicy>
+bool WorkStealingDeque<T, ChunkPolicy>::try_steal(T& value) {
+  std::ptrdiff_t top = top_.load(std::memory_order_seq_cst);
+  std::ptrdiff_t bottom = bottom_.load(std::memory_order_seq_cst);
+  if (top >= bottom) {
+    return false;
+  }
+  Ring* ring = ring_.load(std::memory_order_acquire);
+  T candidate = ring->slot(top).load(std::memory_order_relaxed);
+  if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                    std::memory_order_relaxed)) {
+    return false;
+  }
+  value = candidate;
+  return true;
+}
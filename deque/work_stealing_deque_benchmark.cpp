@@ -0,0 +1,98 @@
+// Fork-join scaling of WorkStealingDeque: computes fib(n) with one deque per
+// worker, splitting every task above a cutoff into two children, for 1..N
+// workers. Not part of any build; run it with
+//   g++ -std=c++20 -O2 -pthread deque/work_stealing_deque_benchmark.cpp
+//       -o steal_bench && ./steal_bench [n] [max workers]
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include "work_stealing_deque.h"
+
+namespace {
+
+const int kCutoff = 20;
+
+uint64_t SerialFib(int n) {
+  return n < 2 ? n : SerialFib(n - 1) + SerialFib(n - 2);
+}
+
+// A task is the argument of the fib call it stands for. Tasks below the
+// cutoff add their value to the worker's sum; the rest fork into n - 1 and
+// n - 2. pending counts tasks not yet run, so zero means the join is done.
+uint64_t ParallelFib(int n, size_t workers) {
+  std::vector<std::unique_ptr<WorkStealingDeque<int>>> deques;
+  for (size_t i = 0; i < workers; ++i) {
+    deques.push_back(std::make_unique<WorkStealingDeque<int>>());
+  }
+  std::atomic<int64_t> pending{1};
+  std::atomic<uint64_t> total{0};
+  deques[0]->push_back(n);
+  auto work = [&](size_t self) {
+    std::minstd_rand random(static_cast<unsigned>(self + 1));
+    uint64_t sum = 0;
+    int task;
+    while (pending.load(std::memory_order_acquire) != 0) {
+      if (!deques[self]->try_pop_back(task) and
+          !deques[random() % workers]->try_steal(task)) {
+        std::this_thread::yield();
+        continue;
+      }
+      if (task < kCutoff) {
+        sum += SerialFib(task);
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+      } else {
+        pending.fetch_add(1, std::memory_order_relaxed);
+        deques[self]->push_back(task - 2);
+        deques[self]->push_back(task - 1);
+      }
+    }
+    total.fetch_add(sum, std::memory_order_relaxed);
+  };
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < workers; ++i) {
+    threads.emplace_back(work, i);
+  }
+  work(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return total.load();
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  int n = argc > 1 ? std::atoi(argv[1]) : 40;
+  size_t max_workers = argc > 2 ? std::strtoull(argv[2], nullptr, 10)
+                                : std::thread::hardware_concurrency();
+  if (max_workers == 0) {
+    max_workers = 1;
+  }
+  uint64_t expected = SerialFib(n);
+  std::printf("fib(%d), cutoff %d, %u hardware threads\n", n, kCutoff,
+              std::thread::hardware_concurrency());
+  double base = 0;
+  for (size_t workers = 1; workers <= max_workers; workers *= 2) {
+    auto start = std::chrono::steady_clock::now();
+    uint64_t result = ParallelFib(n, workers);
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    if (result != expected) {
+      std::fprintf(stderr, "FAILED: fib(%d) = %llu, expected %llu\n", n,
+                   static_cast<unsigned long long>(result),
+                   static_cast<unsigned long long>(expected));
+      return 1;
+    }
+    if (workers == 1) {
+      base = elapsed.count();
+    }
+    std::printf("%3zu workers  %8.3f s  speed-up %5.2f\n", workers,
+                elapsed.count(), base / elapsed.count());
+  }
+}
@@ -50,6 +50,14 @@ class StackAllocator {
   [[nodiscard]] void* get_storage() const { return storage_; }
   [[nodiscard]] void** get_ptr_to_storage() const { return ptr_to_storage_; };
   [[nodiscard]] size_t get_size() const { return size_; }
+  template <typename U>
+  bool operator==(const StackAllocator<U, N>& other) const {
+    return ptr_to_storage_ == other.get_ptr_to_storage();
+  }
+  template <typename U>
+  bool operator!=(const StackAllocator<U, N>& other) const {
+    return !(*this == other);
+  }
 };
 
 template <typename T, size_t N>
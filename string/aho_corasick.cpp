@@ -0,0 +1,141 @@
+#include "aho_corasick.h"
+#include <queue>
+
+AhoCorasick::AhoCorasick(const std::vector<String>& patterns) {
+  pattern_lengths_.reserve(patterns.size());
+  for (const String& pattern : patterns) {
+    pattern_lengths_.push_back(pattern.length());
+  }
+  build_classes(patterns);
+  build_trie(patterns);
+  build_links();
+}
+
+AhoCorasick::MatchRange AhoCorasick::matches(StringView text) const {
+  return {this, text.data(), text.length()};
+}
+
+uint32_t AhoCorasick::add_state() {
+  transitions_.resize(transitions_.size() + class_count_, kNoState);
+  output_link_.push_back(kNoState);
+  return static_cast<uint32_t>(output_link_.size() - 1);
+}
+
+void AhoCorasick::build_classes(const std::vector<String>& patterns) {
+  for (const String& pattern : patterns) {
+    for (size_t i = 0; i < pattern.length(); ++i) {
+      auto byte = static_cast<unsigned char>(pattern[i]);
+      if (byte_class_[byte] == 0) {
+        byte_class_[byte] = static_cast<uint16_t>(class_count_++);
+      }
+    }
+  }
+}
+
+void AhoCorasick::build_trie(const std::vector<String>& patterns) {
+  add_state();
+  std::vector<std::vector<uint32_t>> state_patterns(1);
+  for (size_t id = 0; id < patterns.size(); ++id) {
+    const String& pattern = patterns[id];
+    if (pattern.empty()) {
+      continue;
+    }
+    uint32_t state = kRoot;
+    for (size_t i = 0; i < pattern.length(); ++i) {
+      uint32_t next = next_state(state, pattern[i]);
+      if (next == kNoState) {
+        next = add_state();
+        state_patterns.emplace_back();
+        transitions_[state * class_count_ +
+                     byte_class_[static_cast<unsigned char>(pattern[i])]] =
+            next;
+      }
+      state = next;
+    }
+    state_patterns[state].push_back(static_cast<uint32_t>(id));
+  }
+  output_begin_.reserve(state_patterns.size() + 1);
+  for (const std::vector<uint32_t>& ids : state_patterns) {
+    output_begin_.push_back(static_cast<uint32_t>(outputs_.size()));
+    outputs_.insert(outputs_.end(), ids.begin(), ids.end());
+  }
+  output_begin_.push_back(static_cast<uint32_t>(outputs_.size()));
+}
+
+void AhoCorasick::build_links() {
+  std::vector<uint32_t> fail(state_count(), kRoot);
+  std::queue<uint32_t> queue;
+  for (uint32_t symbol_class = 0; symbol_class < class_count_;
+       ++symbol_class) {
+    uint32_t& next = transitions_[symbol_class];
+    if (next == kNoState) {
+      next = kRoot;
+    } else {
+      queue.push(next);
+    }
+  }
+  while (!queue.empty()) {
+    uint32_t state = queue.front();
+    queue.pop();
+    uint32_t fail_state = fail[state];
+    output_link_[state] =
+        has_output(fail_state) ? fail_state : output_link_[fail_state];
+    for (uint32_t symbol_class = 0; symbol_class < class_count_;
+         ++symbol_class) {
+      uint32_t& next = transitions_[state * class_count_ + symbol_class];
+      uint32_t fallback =
+          transitions_[fail_state * class_count_ + symbol_class];
+      if (next == kNoState) {
+        next = fallback;
+      } else {
+        fail[next] = fallback;
+        queue.push(next);
+      }
+    }
+  }
+}
+
+AhoCorasick::MatchIterator::MatchIterator(const AhoCorasick* matcher,
+                                          const char* text, size_t length)
+    : matcher_(matcher), text_(text), length_(length) {
+  advance();
+}
+
+AhoCorasick::MatchIterator& AhoCorasick::MatchIterator::operator++() {
+  ++output_index_;
+  advance();
+  return *this;
+}
+
+AhoCorasick::MatchIterator AhoCorasick::MatchIterator::operator++(int) {
+  MatchIterator copy = *this;
+  ++*this;
+  return copy;
+}
+
+void AhoCorasick::MatchIterator::advance() {
+  while (true) {
+    while (output_state_ != kNoState) {
+      if (output_index_ < matcher_->output_begin_[output_state_ + 1]) {
+        uint32_t pattern = matcher_->outputs_[output_index_];
+        match_ = {pattern, position_ - matcher_->pattern_lengths_[pattern]};
+        return;
+      }
+      output_state_ = matcher_->output_link_[output_state_];
+      if (output_state_ != kNoState) {
+        output_index_ = matcher_->output_begin_[output_state_];
+      }
+    }
+    if (position_ == length_) {
+      matcher_ = nullptr;
+      return;
+    }
+    state_ = matcher_->next_state(state_, text_[position_++]);
+    output_state_ = matcher_->has_output(state_)
+                        ? state_
+                        : matcher_->output_link_[state_];
+    if (output_state_ != kNoState) {
+      output_index_ = matcher_->output_begin_[output_state_];
+    }
+  }
+}
@@ -0,0 +1,109 @@
+#pragma once
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include "string.h"
+
+class AhoCorasick {
+ public:
+  struct Match {
+    size_t pattern;
+    size_t position;
+  };
+
+  class MatchIterator;
+  class MatchRange;
+
+  explicit AhoCorasick(const std::vector<String>& patterns);
+  [[nodiscard]] size_t pattern_count() const { return pattern_lengths_.size(); }
+  [[nodiscard]] size_t state_count() const { return output_link_.size(); }
+  template <typename Callback>
+  void for_each_match(StringView text, Callback callback) const;
+  MatchRange matches(StringView text) const;
+
+ private:
+  static constexpr uint32_t kRoot = 0;
+  static constexpr uint32_t kNoState = UINT32_MAX;
+
+  uint16_t byte_class_[256] = {};
+  uint32_t class_count_ = 1;
+  std::vector<uint32_t> transitions_;
+  std::vector<uint32_t> output_begin_;
+  std::vector<uint32_t> outputs_;
+  std::vector<uint32_t> output_link_;
+  std::vector<size_t> pattern_lengths_;
+
+  uint32_t next_state(uint32_t state, char symbol) const {
+    return transitions_[state * class_count_ +
+                        byte_class_[static_cast<unsigned char>(symbol)]];
+  }
+  bool has_output(uint32_t state) const {
+    return output_begin_[state] != output_begin_[state + 1];
+  }
+  uint32_t add_state();
+  void build_classes(const std::vector<String>& patterns);
+  void build_trie(const std::vector<String>& patterns);
+  void build_links();
+};
+
+class AhoCorasick::MatchIterator {
+ public:
+  using value_type = Match;
+  using iterator_category = std::input_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using reference = const Match&;
+  using pointer = const Match*;
+
+  MatchIterator() = default;
+  MatchIterator(const AhoCorasick* matcher, const char* text, size_t length);
+  reference operator*() const { return match_; }
+  pointer operator->() const { return &match_; }
+  MatchIterator& operator++();
+  MatchIterator operator++(int);
+  bool operator==(const MatchIterator& other) const {
+    return matcher_ == other.matcher_;
+  }
+
+ private:
+  const AhoCorasick* matcher_ = nullptr;
+  const char* text_ = nullptr;
+  size_t length_ = 0;
+  size_t position_ = 0;
+  uint32_t state_ = kRoot;
+  uint32_t output_state_ = kNoState;
+  uint32_t output_index_ = 0;
+  Match match_{};
+
+  void advance();
+};
+
+class AhoCorasick::MatchRange {
+ public:
+  MatchRange(const AhoCorasick* matcher, const char* text, size_t length)
+      : matcher_(matcher), text_(text), length_(length) {}
+  MatchIterator begin() const { return {matcher_, text_, length_}; }
+  MatchIterator end() const { return {}; }
+
+ private:
+  const AhoCorasick* matcher_;
+  const char* text_;
+  size_t length_;
+};
+
+template <typename Callback>
+void AhoCorasick::for_each_match(StringView text, Callback callback) const {
+  const char* symbols = text.data();
+  size_t length = text.length();
+  uint32_t state = kRoot;
+  for (size_t i = 0; i < length; ++i) {
+    state = next_state(state, symbols[i]);
+    uint32_t output_state = has_output(state) ? state : output_link_[state];
+    while (output_state != kNoState) {
+      for (uint32_t j = output_begin_[output_state];
+           j < output_begin_[output_state + 1]; ++j) {
+        callback(Match{outputs_[j], i + 1 - pattern_lengths_[outputs_[j]]});
+      }
+      output_state = output_link_[output_state];
+    }
+  }
+}
@@ -0,0 +1,315 @@
+#include "compressed_string.h"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+const size_t kMinMatch = 4;
+const size_t kLastLiterals = 5;
+const size_t kMatchSafety = 12;
+const size_t kMaxOffset = 65535;
+const size_t kMaxVarintLength = 10;
+const size_t kNibbleLimit = 15;
+const int kMinHashBits = 8;
+const int kMaxHashBits = 12;
+const uint32_t kNoPosition = UINT32_MAX;
+
+uint32_t Read32(const char* data) {
+  uint32_t value;
+  std::memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+uint32_t Hash(uint32_t sequence, int bits) {
+  return (sequence * 2654435761U) >> (32 - bits);
+}
+
+char* WriteVarint(char* out, uint64_t value) {
+  while (value >= 0x80) {
+    *out++ = static_cast<char>(value | 0x80);
+    value >>= 7;
+  }
+  *out++ = static_cast<char>(value);
+  return out;
+}
+
+uint64_t ReadVarint(const char*& in, const char* end) {
+  uint64_t value = 0;
+  for (int shift = 0; in != end and shift < 64; shift += 7) {
+    auto byte = static_cast<unsigned char>(*in++);
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if (byte < 0x80) {
+      return value;
+    }
+  }
+  throw std::runtime_error("Corrupt compressed string");
+}
+
+char* WriteLength(char* out, size_t length) {
+  for (; length >= 255; length -= 255) {
+    *out++ = static_cast<char>(255);
+  }
+  *out++ = static_cast<char>(length);
+  return out;
+}
+
+size_t ReadLength(size_t nibble, const char*& in, const char* end) {
+  if (nibble < kNibbleLimit) {
+    return nibble;
+  }
+  size_t length = nibble;
+  unsigned char byte = 255;
+  while (byte == 255) {
+    if (in == end) {
+      throw std::runtime_error("Corrupt compressed string");
+    }
+    byte = static_cast<unsigned char>(*in++);
+    length += byte;
+  }
+  return length;
+}
+
+char* WriteSequence(char* out, StringView literals, size_t offset,
+                    size_t match_length) {
+  size_t extra = match_length == 0 ? 0 : match_length - kMinMatch;
+  char* token = out++;
+  *token = static_cast<char>(std::min(extra, kNibbleLimit));
+  if (literals.length() >= kNibbleLimit) {
+    *token = static_cast<char>(*token | kNibbleLimit << 4);
+    out = WriteLength(out, literals.length() - kNibbleLimit);
+  } else {
+    *token = static_cast<char>(*token | literals.length() << 4);
+  }
+  out = std::copy(literals.begin(), literals.end(), out);
+  if (match_length == 0) {
+    return out;
+  }
+  *out++ = static_cast<char>(offset & 0xFF);
+  *out++ = static_cast<char>(offset >> 8);
+  if (extra >= kNibbleLimit) {
+    out = WriteLength(out, extra - kNibbleLimit);
+  }
+  return out;
+}
+
+size_t Compress(StringView text, const String* dictionary,
+                const std::vector<uint32_t>* dictionary_table, char* out) {
+  const char* input = text.data();
+  size_t length = text.length();
+  char* begin = out;
+  size_t anchor = 0;
+  if (length > kMatchSafety) {
+    int bits = std::clamp(static_cast<int>(std::bit_width(length)),
+                          kMinHashBits, kMaxHashBits);
+    size_t table[size_t(1) << kMaxHashBits];
+    std::fill(table, table + (size_t(1) << bits), SIZE_MAX);
+    size_t dictionary_length = dictionary ? dictionary->length() : 0;
+    size_t match_limit = length - kLastLiterals;
+    size_t position = 0;
+    while (position < length - kMatchSafety) {
+      uint32_t sequence = Read32(input + position);
+      uint32_t hash = Hash(sequence, bits);
+      size_t candidate = table[hash];
+      table[hash] = position;
+      size_t offset = 0;
+      size_t match_length = 0;
+      if (candidate != SIZE_MAX and position - candidate <= kMaxOffset and
+          Read32(input + candidate) == sequence) {
+        match_length = kMinMatch + FindMismatch(input + candidate + kMinMatch,
+                                                input + position + kMinMatch,
+                                                match_limit - position -
+                                                    kMinMatch);
+        while (position > anchor and candidate > 0 and
+               input[position - 1] == input[candidate - 1]) {
+          --position;
+          --candidate;
+          ++match_length;
+        }
+        offset = position - candidate;
+      } else if (dictionary != nullptr) {
+        uint32_t entry = (*dictionary_table)[Hash(sequence, kMaxHashBits)];
+        if (entry != kNoPosition and
+            dictionary_length - entry + position <= kMaxOffset and
+            Read32(dictionary->data() + entry) == sequence) {
+          size_t room = std::min(dictionary_length - entry,
+                                 match_limit - position);
+          match_length = FindMismatch(dictionary->data() + entry,
+                                      input + position, room);
+          offset = dictionary_length - entry + position;
+        }
+      }
+      if (match_length < kMinMatch) {
+        position += 1 + ((position - anchor) >> 6);
+        continue;
+      }
+      out = WriteSequence(
+          out, StringView(input + anchor, position - anchor), offset,
+          match_length);
+      position += match_length;
+      anchor = position;
+      table[Hash(Read32(input + position - 2), bits)] = position - 2;
+    }
+  }
+  out = WriteSequence(out, StringView(input + anchor, length - anchor), 0, 0);
+  return out - begin;
+}
+
+void Decompress(const char* in, const char* end, StringView dictionary,
+                char* out, size_t length) {
+  size_t produced = 0;
+  while (in != end) {
+    auto token = static_cast<unsigned char>(*in++);
+    size_t literal_length = ReadLength(token >> 4, in, end);
+    if (literal_length > static_cast<size_t>(end - in) or
+        literal_length > length - produced) {
+      throw std::runtime_error("Corrupt compressed string");
+    }
+    std::memcpy(out + produced, in, literal_length);
+    in += literal_length;
+    produced += literal_length;
+    if (in == end) {
+      break;
+    }
+    if (end - in < 2) {
+      throw std::runtime_error("Corrupt compressed string");
+    }
+    size_t offset = static_cast<unsigned char>(in[0]) |
+                    static_cast<size_t>(static_cast<unsigned char>(in[1]))
+                        << 8;
+    in += 2;
+    size_t match_length = ReadLength(token & kNibbleLimit, in, end) +
+                          kMinMatch;
+    if (offset == 0 or offset > produced + dictionary.length() or
+        match_length > length - produced) {
+      throw std::runtime_error("Corrupt compressed string");
+    }
+    if (offset > produced) {
+      size_t from_dictionary = std::min(offset - produced, match_length);
+      std::memcpy(out + produced, dictionary.end() - (offset - produced),
+                  from_dictionary);
+      produced += from_dictionary;
+      match_length -= from_dictionary;
+    }
+    char* target = out + produced;
+    if (offset >= match_length) {
+      std::memcpy(target, target - offset, match_length);
+    } else {
+      for (size_t i = 0; i < match_length; ++i) {
+        target[i] = target[i - offset];
+      }
+    }
+    produced += match_length;
+  }
+  if (produced != length) {
+    throw std::runtime_error("Corrupt compressed string");
+  }
+}
+
+}  // namespace
+
+CompressionDictionary::CompressionDictionary(StringView samples)
+    : data_(samples.length() > kMaxSize
+                ? samples.substr(samples.length() - kMaxSize, kMaxSize)
+                : samples),
+      table_(size_t(1) << kMaxHashBits, kNoPosition) {
+  for (size_t i = 0; i + kMinMatch <= data_.length(); ++i) {
+    table_[Hash(Read32(data_.data() + i), kMaxHashBits)] =
+        static_cast<uint32_t>(i);
+  }
+}
+
+CompressedString::CompressedString(StringView text,
+                                   const CompressionDictionary* dictionary)
+    : dictionary_(dictionary) {
+  size_t length = text.length();
+  auto buffer = std::make_unique_for_overwrite<char[]>(
+      kMaxVarintLength + length + length / 255 + 16);
+  char* body = WriteVarint(buffer.get(), length << 1 | 1);
+  size_t body_size = Compress(text, dictionary ? &dictionary->data_ : nullptr,
+                              dictionary ? &dictionary->table_ : nullptr,
+                              body);
+  if (body_size >= length) {
+    body = WriteVarint(buffer.get(), length << 1);
+    std::copy(text.begin(), text.end(), body);
+    body_size = length;
+  }
+  compressed_ =
+      String(StringView(buffer.get(), body - buffer.get() + body_size));
+}
+
+CompressedString::CompressedString(const CompressedString& string)
+    : compressed_(string.compressed_),
+      dictionary_(string.dictionary_),
+      cache_(string.copy_cache()) {}
+
+CompressedString::CompressedString(CompressedString&& string) noexcept
+    : compressed_(std::move(string.compressed_)),
+      dictionary_(string.dictionary_),
+      cache_(string.cache_.exchange(nullptr, std::memory_order_relaxed)) {}
+
+CompressedString& CompressedString::operator=(const CompressedString& string) {
+  if (this != &string) {
+    compressed_ = string.compressed_;
+    dictionary_ = string.dictionary_;
+    reset_cache(string.copy_cache());
+  }
+  return *this;
+}
+
+CompressedString& CompressedString::operator=(
+    CompressedString&& string) noexcept {
+  if (this != &string) {
+    compressed_ = std::move(string.compressed_);
+    dictionary_ = string.dictionary_;
+    reset_cache(string.cache_.exchange(nullptr, std::memory_order_relaxed));
+  }
+  return *this;
+}
+
+size_t CompressedString::length() const {
+  if (compressed_.empty()) {
+    return 0;
+  }
+  const char* in = compressed_.data();
+  return ReadVarint(in, in + compressed_.length()) >> 1;
+}
+
+std::shared_ptr<const String> CompressedString::decompress() const {
+  if (const Cache* cache = cache_.load(std::memory_order_acquire)) {
+    return *cache;
+  }
+  const char* in = compressed_.data();
+  const char* end = in + compressed_.length();
+  uint64_t header = compressed_.empty() ? 0 : ReadVarint(in, end);
+  size_t length = header >> 1;
+  auto text = std::make_shared<String>(length, '\0');
+  if ((header & 1) != 0) {
+    Decompress(in, end, dictionary_ ? dictionary_->data() : StringView(),
+               text->data(), length);
+  } else {
+    std::copy(in, end, text->data());
+  }
+  auto cache = std::make_unique<const Cache>(std::move(text));
+  const Cache* expected = nullptr;
+  if (cache_.compare_exchange_strong(expected, cache.get(),
+                                     std::memory_order_acq_rel,
+                                     std::memory_order_acquire)) {
+    return *cache.release();
+  }
+  return *expected;
+}
+
+const CompressedString::Cache* CompressedString::copy_cache() const {
+  const Cache* cache = cache_.load(std::memory_order_acquire);
+  return cache == nullptr ? nullptr : new const Cache(*cache);
+}
+
+void CompressedString::reset_cache(const Cache* cache) {
+  delete cache_.exchange(cache, std::memory_order_acq_rel);
+}
+
+std::ostream& operator<<(std::ostream& out, const CompressedString& string) {
+  return out << *string.decompress();
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "string.h"
+
+class CompressionDictionary {
+ public:
+  static const size_t kMaxSize = 65535;
+
+  explicit CompressionDictionary(StringView samples);
+  [[nodiscard]] StringView data() const { return data_; }
+
+ private:
+  friend class CompressedString;
+
+  String data_;
+  std::vector<uint32_t> table_;
+};
+
+class CompressedString {
+ public:
+  CompressedString() = default;
+  explicit CompressedString(StringView text,
+                            const CompressionDictionary* dictionary = nullptr);
+  CompressedString(const CompressedString& string);
+  CompressedString(CompressedString&& string) noexcept;
+  CompressedString& operator=(const CompressedString& string);
+  CompressedString& operator=(CompressedString&& string) noexcept;
+  ~CompressedString() { reset_cache(nullptr); }
+  [[nodiscard]] size_t length() const;
+  [[nodiscard]] size_t size() const { return length(); }
+  [[nodiscard]] bool empty() const { return length() == 0; }
+  [[nodiscard]] size_t compressed_size() const {
+    return compressed_.length();
+  }
+  // Safe to call from several threads on the same object; the text is
+  // decompressed once and shared with the cache.
+  std::shared_ptr<const String> decompress() const;
+  // Frees the cached text. Like every non-const member it needs exclusive
+  // access to the object. Pointers returned by decompress() stay valid, but
+  // StringViews taken through the conversion below dangle.
+  void drop_cache() { reset_cache(nullptr); }
+  // Points into the cache: valid until drop_cache(), assignment or
+  // destruction.
+  operator StringView() const { return *decompress(); }
+
+ private:
+  using Cache = std::shared_ptr<const String>;
+
+  String compressed_;
+  const CompressionDictionary* dictionary_ = nullptr;
+  // Null until the first decompress(), which publishes the block with a
+  // compare-exchange. A single pointer keeps cold objects small.
+  mutable std::atomic<const Cache*> cache_{nullptr};
+
+  const Cache* copy_cache() const;
+  void reset_cache(const Cache* cache);
+};
+
+std::ostream& operator<<(std::ostream& out, const CompressedString& string);
@@ -0,0 +1,155 @@
+// Compression ratio and encode/decode throughput of CompressedString on
+// large log and JSON payloads, random bytes, and many small similar records
+// with and without a shared dictionary. Not part of any build; run it with
+//   g++ -std=c++20 -O2 string/compressed_string_benchmark.cpp
+//       $(ls string/*.cpp | grep -v _benchmark) -o compress_bench
+//   ./compress_bench
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "compressed_string.h"
+
+namespace {
+
+const size_t kLargeSize = size_t(8) << 20;
+const size_t kRecords = 100000;
+
+std::minstd_rand random_source(17);
+
+String LogLine() {
+  const char* const kLevels[] = {"INFO", "WARN", "DEBUG", "ERROR"};
+  const char* const kPaths[] = {"/api/v2/orders", "/api/v2/users/me",
+                                "/healthz", "/api/v1/search"};
+  String line("2026-10-18T12:");
+  line.append_uint(10 + random_source() % 50);
+  line += ":";
+  line.append_uint(10 + random_source() % 50);
+  line += ".";
+  line.append_uint(100000 + random_source() % 900000);
+  line += "Z ";
+  line += kLevels[random_source() % 4];
+  line += " http method=GET path=";
+  line += kPaths[random_source() % 4];
+  line += " status=200 latency_ms=";
+  line.append_uint(random_source() % 900);
+  line += " request_id=";
+  line.append_uint(random_source());
+  line += '\n';
+  return line;
+}
+
+String JsonRecord() {
+  String record("{\"user_id\":");
+  record.append_uint(random_source() % 10000000);
+  record += ",\"name\":\"user";
+  record.append_uint(random_source() % 100000);
+  record += "\",\"country\":\"";
+  record += random_source() % 2 ? "DE" : "US";
+  record += "\",\"balance\":";
+  record.append_double((random_source() % 1000000) / 100.0);
+  record += ",\"active\":";
+  record += random_source() % 2 ? "true" : "false";
+  record += ",\"tags\":[\"premium\",\"newsletter\"]}";
+  return record;
+}
+
+String RandomBytes(size_t length) {
+  String bytes(length, '\0');
+  for (size_t i = 0; i < length; ++i) {
+    bytes[i] = static_cast<char>(random_source());
+  }
+  return bytes;
+}
+
+template <typename Make>
+String Repeat(Make make, size_t length) {
+  String text;
+  while (text.length() < length) {
+    text += make();
+  }
+  return text;
+}
+
+double Seconds(std::chrono::steady_clock::time_point start) {
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+void Expect(bool condition, const char* what) {
+  if (!condition) {
+    std::fprintf(stderr, "FAILED: %s\n", what);
+    std::exit(1);
+  }
+}
+
+void Report(const char* name, size_t original, size_t stored,
+            double encode_seconds, double decode_seconds) {
+  std::printf("%-26s %6.2f %12.0f %12.0f\n", name, double(original) / stored,
+              original / encode_seconds / 1e6,
+              original / decode_seconds / 1e6);
+}
+
+void Large(const char* name, const String& text) {
+  auto start = std::chrono::steady_clock::now();
+  CompressedString compressed(text);
+  double encode_seconds = Seconds(start);
+  const int kDecodes = 10;
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kDecodes; ++i) {
+    compressed.drop_cache();
+    Expect(compressed.decompress()->length() == text.length(),
+           "decoded length");
+  }
+  double decode_seconds = Seconds(start) / kDecodes;
+  Expect(StringView(*compressed.decompress()) == text, "round trip");
+  Report(name, text.length(), compressed.compressed_size(), encode_seconds,
+         decode_seconds);
+}
+
+// Stored size includes the objects themselves, which dominate for records
+// this small.
+void Records(const char* name, const std::vector<String>& records,
+             const CompressionDictionary* dictionary) {
+  size_t original = 0;
+  size_t stored = 0;
+  std::vector<CompressedString> compressed;
+  compressed.reserve(records.size());
+  auto start = std::chrono::steady_clock::now();
+  for (const String& record : records) {
+    compressed.emplace_back(record, dictionary);
+  }
+  double encode_seconds = Seconds(start);
+  start = std::chrono::steady_clock::now();
+  for (const CompressedString& string : compressed) {
+    original += string.decompress()->length();
+  }
+  double decode_seconds = Seconds(start);
+  for (size_t i = 0; i < records.size(); ++i) {
+    Expect(StringView(*compressed[i].decompress()) == records[i],
+           "record round trip");
+    stored += compressed[i].compressed_size() + sizeof(CompressedString);
+  }
+  Report(name, original, stored, encode_seconds, decode_seconds);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("sizeof(CompressedString) = %zu\n", sizeof(CompressedString));
+  std::printf("%-26s %6s %12s %12s\n", "", "ratio", "encode MB/s",
+              "decode MB/s");
+  Large("8 MB of log lines", Repeat(LogLine, kLargeSize));
+  Large("8 MB of JSON records", Repeat(JsonRecord, kLargeSize));
+  Large("8 MB of random bytes", RandomBytes(kLargeSize));
+
+  std::vector<String> records;
+  for (size_t i = 0; i < kRecords; ++i) {
+    records.push_back(JsonRecord());
+  }
+  CompressionDictionary dictionary(Repeat(JsonRecord, 4096));
+  Records("100k JSON records", records, nullptr);
+  Records("100k JSON records + dict", records, &dictionary);
+}
@@ -0,0 +1,34 @@
+#pragma once
+#include <functional>
+#include "string.h"
+
+class HashedString {
+ public:
+  explicit HashedString(String string)
+      : string_(std::move(string)), hash_(std::hash<String>()(string_)) {}
+  [[nodiscard]] const String& string() const { return string_; }
+  [[nodiscard]] size_t hash() const { return hash_; }
+  [[nodiscard]] size_t length() const { return string_.length(); }
+  [[nodiscard]] const char* data() const { return string_.data(); }
+  operator StringView() const { return string_; }
+
+ private:
+  String string_;
+  size_t hash_;
+};
+
+inline bool operator==(const HashedString& string1,
+                       const HashedString& string2) {
+  return string1.hash() == string2.hash() and
+         string1.string() == string2.string();
+}
+
+inline bool operator!=(const HashedString& string1,
+                       const HashedString& string2) {
+  return !(string1 == string2);
+}
+
+template <>
+struct std::hash<HashedString> {
+  size_t operator()(const HashedString& string) const { return string.hash(); }
+};
@@ -0,0 +1,46 @@
+#include "monotonic_arena.h"
+#include <algorithm>
+#include <memory>
+
+MonotonicArena::MonotonicArena(size_t block_size)
+    : block_size_(block_size),
+      blocks_(nullptr),
+      current_(nullptr),
+      end_(nullptr),
+      bytes_allocated_(0) {}
+
+void* MonotonicArena::allocate(size_t bytes, size_t alignment) {
+  void* result = current_;
+  size_t space = end_ - current_;
+  if (current_ == nullptr or
+      std::align(alignment, bytes, result, space) == nullptr) {
+    add_block(bytes + alignment);
+    result = current_;
+    space = end_ - current_;
+    std::align(alignment, bytes, result, space);
+  }
+  current_ = static_cast<char*>(result) + bytes;
+  bytes_allocated_ += bytes;
+  return result;
+}
+
+void MonotonicArena::release() {
+  while (blocks_ != nullptr) {
+    Block* next = blocks_->next;
+    ::operator delete(blocks_);
+    blocks_ = next;
+  }
+  current_ = nullptr;
+  end_ = nullptr;
+  bytes_allocated_ = 0;
+}
+
+void MonotonicArena::add_block(size_t min_size) {
+  size_t size = std::max(block_size_, min_size + sizeof(Block));
+  auto* block = static_cast<Block*>(::operator new(size));
+  block->next = blocks_;
+  block->size = size;
+  blocks_ = block;
+  current_ = reinterpret_cast<char*>(block + 1);
+  end_ = reinterpret_cast<char*>(block) + size;
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <cstddef>
+#include <tuple>
+#include "string.h"
+
+class MonotonicArena {
+ public:
+  static const size_t kDefaultBlockSize = 1 << 16;
+
+  explicit MonotonicArena(size_t block_size = kDefaultBlockSize);
+  MonotonicArena(const MonotonicArena&) = delete;
+  MonotonicArena& operator=(const MonotonicArena&) = delete;
+  ~MonotonicArena() { release(); }
+  void* allocate(size_t bytes, size_t alignment);
+  void release();
+  [[nodiscard]] size_t bytes_allocated() const { return bytes_allocated_; }
+
+ private:
+  struct Block {
+    Block* next;
+    size_t size;
+  };
+
+  size_t block_size_;
+  Block* blocks_;
+  char* current_;
+  char* end_;
+  size_t bytes_allocated_;
+
+  void add_block(size_t min_size);
+};
+
+template <typename T>
+class ArenaAllocator {
+ public:
+  using value_type = T;
+  using pointer = T*;
+  using size_type = size_t;
+
+  ArenaAllocator(MonotonicArena& arena) : arena_(&arena) {}
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& allocator)
+      : arena_(allocator.get_arena()) {}
+  T* allocate(size_type n) {
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(pointer ptr, size_type n) {
+    std::ignore = ptr;
+    std::ignore = n;
+  }
+  [[nodiscard]] MonotonicArena* get_arena() const { return arena_; }
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const {
+    return arena_ == other.get_arena();
+  }
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const {
+    return arena_ != other.get_arena();
+  }
+
+ private:
+  MonotonicArena* arena_;
+};
+
+using ArenaString = BasicString<ArenaAllocator<char>>;
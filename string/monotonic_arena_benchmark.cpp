@@ -0,0 +1,88 @@
+// Request-sized workload on String with the default allocator against
+// ArenaString on a MonotonicArena released once per request. A request
+// builds a few hundred header, path and body strings, most of them past
+// the inline buffer, then drops all of them. Not part of any build; run it
+// with
+//   g++ -std=c++20 -O2 string/monotonic_arena_benchmark.cpp
+//       $(ls string/*.cpp | grep -v _benchmark) -o arena_bench && ./arena_bench
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+#include "monotonic_arena.h"
+
+size_t allocation_count = 0;
+
+void* operator new(size_t size) {
+  ++allocation_count;
+  if (void* memory = std::malloc(size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+
+namespace {
+
+const size_t kRequests = 20000;
+const size_t kHeaders = 200;
+
+const char* const kNames[] = {"content-type", "x-request-id", "user-agent",
+                              "accept-encoding", "x-forwarded-for"};
+
+size_t sink = 0;
+
+template <typename StringType, typename Allocator>
+void Request(size_t request, const Allocator& allocator) {
+  std::vector<StringType> headers;
+  headers.reserve(kHeaders);
+  for (size_t i = 0; i < kHeaders; ++i) {
+    StringType header(kNames[i % 5], allocator);
+    header += ": ";
+    header.append_uint(request * kHeaders + i);
+    header += "; session=a81f7c2e90d34b56";
+    headers.push_back(std::move(header));
+  }
+  StringType path("/api/v2/users/", allocator);
+  path.append_uint(request);
+  path += "/orders?limit=50&cursor=eyJpZCI6MTIzNDU2fQ";
+  StringType body(allocator);
+  for (const StringType& header : headers) {
+    body += header;
+    body += '\n';
+  }
+  sink += path.length() + body.length();
+}
+
+template <typename Run>
+void Measure(const char* name, Run run) {
+  size_t allocations_before = allocation_count;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t request = 0; request < kRequests; ++request) {
+    run(request);
+  }
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::printf("%-34s %8.2f us/request %8.1f mallocs/request\n", name,
+              elapsed.count() / kRequests,
+              double(allocation_count - allocations_before) / kRequests);
+}
+
+}  // namespace
+
+int main() {
+  Measure("String, default allocator", [](size_t request) {
+    Request<String>(request, std::allocator<char>());
+  });
+  Measure("ArenaString, arena per request", [](size_t request) {
+    MonotonicArena arena;
+    Request<ArenaString>(request, ArenaAllocator<char>(arena));
+  });
+  std::printf("checksum %zu\n", sink);
+}
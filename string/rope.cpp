@@ -0,0 +1,217 @@
+#include "rope.h"
+
+namespace {
+
+uint64_t NextPriority() {
+  thread_local uint64_t state = 0x9E3779B97F4A7C15ULL;
+  state += 0x9E3779B97F4A7C15ULL;
+  uint64_t result = state;
+  result = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  result = (result ^ (result >> 27)) * 0x94D049BB133111EBULL;
+  return result ^ (result >> 31);
+}
+
+}  // namespace
+
+Rope::Rope(StringView text) : root_(Build(text)) {}
+
+Rope::Rope(const Rope& rope) : root_(rope.root_), flat_(rope.cached_flat()) {}
+
+Rope::Rope(Rope&& rope) noexcept
+    : root_(std::move(rope.root_)), flat_(std::move(rope.flat_)) {}
+
+Rope& Rope::operator=(const Rope& rope) {
+  root_ = rope.root_;
+  flat_ = rope.cached_flat();
+  return *this;
+}
+
+Rope& Rope::operator=(Rope&& rope) noexcept {
+  root_ = std::move(rope.root_);
+  flat_ = std::move(rope.flat_);
+  return *this;
+}
+
+char Rope::operator[](size_t ind) const {
+  const Node* node = root_.get();
+  while (true) {
+    size_t left_length = Length(node->left);
+    if (ind < left_length) {
+      node = node->left.get();
+    } else if (ind < left_length + node->chunk_length) {
+      return node->chunk()[ind - left_length];
+    } else {
+      ind -= left_length + node->chunk_length;
+      node = node->right.get();
+    }
+  }
+}
+
+void Rope::insert(size_t position, StringView text) {
+  insert(position, Rope(text));
+}
+
+void Rope::insert(size_t position, const Rope& rope) {
+  auto [left, right] = Split(root_, position);
+  set_root(Join(Join(left, rope.root_), right));
+}
+
+void Rope::erase(size_t start, size_t count) {
+  auto [left, rest] = Split(root_, start);
+  set_root(Join(left, Split(rest, count).second));
+}
+
+Rope& Rope::operator+=(StringView text) { return *this += Rope(text); }
+
+Rope& Rope::operator+=(const Rope& rope) {
+  set_root(Join(root_, rope.root_));
+  return *this;
+}
+
+Rope Rope::substr(size_t start, size_t count) const {
+  return Rope(Split(Split(root_, start).second, count).first);
+}
+
+std::shared_ptr<const String> Rope::flatten() const {
+  std::lock_guard lock(flat_mutex_);
+  if (flat_ == nullptr) {
+    auto flat = std::make_shared<String>();
+    flat->reserve(length());
+    for_each_chunk([&flat](StringView chunk) { *flat += chunk; });
+    flat_ = std::move(flat);
+  }
+  return flat_;
+}
+
+std::shared_ptr<const String> Rope::cached_flat() const {
+  std::lock_guard lock(flat_mutex_);
+  return flat_;
+}
+
+void Rope::set_root(NodePtr root) {
+  root_ = std::move(root);
+  flat_.reset();
+}
+
+size_t Rope::Length(const NodePtr& node) {
+  return node == nullptr ? 0 : node->length;
+}
+
+Rope::NodePtr Rope::Build(StringView text) {
+  NodePtr root;
+  for (size_t start = 0; start < text.length(); start += kChunkSize) {
+    auto buffer =
+        std::make_shared<const String>(text.substr(start, kChunkSize));
+    size_t chunk_length = buffer->length();
+    root = Merge(root, MakeLeaf(std::move(buffer), 0, chunk_length));
+  }
+  return root;
+}
+
+Rope::NodePtr Rope::MakeLeaf(std::shared_ptr<const String> buffer,
+                             size_t offset, size_t length) {
+  if (length == 0) {
+    return nullptr;
+  }
+  return std::make_shared<const Node>(Node{std::move(buffer), offset, length,
+                                           length, NextPriority(), nullptr,
+                                           nullptr});
+}
+
+Rope::NodePtr Rope::MakeNode(const Node& node, NodePtr left, NodePtr right) {
+  size_t length = Length(left) + node.chunk_length + Length(right);
+  return std::make_shared<const Node>(Node{node.buffer, node.offset,
+                                           node.chunk_length, length,
+                                           node.priority, std::move(left),
+                                           std::move(right)});
+}
+
+Rope::NodePtr Rope::Merge(const NodePtr& left, const NodePtr& right) {
+  if (left == nullptr) {
+    return right;
+  }
+  if (right == nullptr) {
+    return left;
+  }
+  if (left->priority > right->priority) {
+    return MakeNode(*left, left->left, Merge(left->right, right));
+  }
+  return MakeNode(*right, Merge(left, right->left), right->right);
+}
+
+Rope::NodePtr Rope::Join(const NodePtr& left, const NodePtr& right) {
+  if (left == nullptr or right == nullptr) {
+    return Merge(left, right);
+  }
+  const Node* last = left.get();
+  while (last->right != nullptr) {
+    last = last->right.get();
+  }
+  const Node* first = right.get();
+  while (first->left != nullptr) {
+    first = first->left.get();
+  }
+  size_t length = last->chunk_length + first->chunk_length;
+  if (length > kChunkSize) {
+    return Merge(left, right);
+  }
+  auto buffer = std::make_shared<String>();
+  buffer->reserve(length);
+  *buffer += last->chunk();
+  *buffer += first->chunk();
+  NodePtr leaf = MakeLeaf(std::move(buffer), 0, length);
+  return Merge(Merge(RemoveLast(left), leaf), RemoveFirst(right));
+}
+
+Rope::NodePtr Rope::RemoveFirst(const NodePtr& node) {
+  if (node->left == nullptr) {
+    return node->right;
+  }
+  return MakeNode(*node, RemoveFirst(node->left), node->right);
+}
+
+Rope::NodePtr Rope::RemoveLast(const NodePtr& node) {
+  if (node->right == nullptr) {
+    return node->left;
+  }
+  return MakeNode(*node, node->left, RemoveLast(node->right));
+}
+
+std::pair<Rope::NodePtr, Rope::NodePtr> Rope::Split(const NodePtr& node,
+                                                    size_t position) {
+  if (node == nullptr) {
+    return {nullptr, nullptr};
+  }
+  if (position == 0) {
+    return {nullptr, node};
+  }
+  if (position >= node->length) {
+    return {node, nullptr};
+  }
+  size_t left_length = Length(node->left);
+  if (position <= left_length) {
+    auto [left, right] = Split(node->left, position);
+    return {left, MakeNode(*node, right, node->right)};
+  }
+  size_t chunk_end = left_length + node->chunk_length;
+  if (position >= chunk_end) {
+    auto [left, right] = Split(node->right, position - chunk_end);
+    return {MakeNode(*node, node->left, left), right};
+  }
+  size_t cut = position - left_length;
+  NodePtr head = MakeLeaf(node->buffer, node->offset, cut);
+  NodePtr tail = MakeLeaf(node->buffer, node->offset + cut,
+                          node->chunk_length - cut);
+  return {Merge(node->left, head), Merge(tail, node->right)};
+}
+
+Rope operator+(const Rope& rope1, const Rope& rope2) {
+  Rope result = rope1;
+  result += rope2;
+  return result;
+}
+
+std::ostream& operator<<(std::ostream& out, const Rope& rope) {
+  rope.for_each_chunk([&out](StringView chunk) { out << chunk; });
+  return out;
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include "string.h"
+
+class Rope {
+ public:
+  static const size_t kChunkSize = 1024;
+
+  Rope() = default;
+  explicit Rope(StringView text);
+  Rope(const Rope& rope);
+  Rope(Rope&& rope) noexcept;
+  Rope& operator=(const Rope& rope);
+  Rope& operator=(Rope&& rope) noexcept;
+  [[nodiscard]] size_t length() const { return Length(root_); }
+  [[nodiscard]] size_t size() const { return length(); }
+  [[nodiscard]] bool empty() const { return root_ == nullptr; }
+  char operator[](size_t ind) const;
+  void insert(size_t position, StringView text);
+  void insert(size_t position, const Rope& rope);
+  void erase(size_t start, size_t count);
+  Rope& operator+=(StringView text);
+  Rope& operator+=(const Rope& rope);
+  Rope substr(size_t start, size_t count) const;
+  // Safe to call from several threads on the same rope. The result is
+  // shared with the rope's cache and outlives any later change to it.
+  std::shared_ptr<const String> flatten() const;
+  template <typename Callback>
+  void for_each_chunk(Callback callback) const {
+    VisitChunks(root_.get(), callback);
+  }
+
+ private:
+  struct Node;
+  using NodePtr = std::shared_ptr<const Node>;
+
+  NodePtr root_;
+  mutable std::mutex flat_mutex_;
+  mutable std::shared_ptr<const String> flat_;
+
+  explicit Rope(NodePtr root) : root_(std::move(root)) {}
+  void set_root(NodePtr root);
+  std::shared_ptr<const String> cached_flat() const;
+
+  static size_t Length(const NodePtr& node);
+  static NodePtr Build(StringView text);
+  static NodePtr MakeLeaf(std::shared_ptr<const String> buffer, size_t offset,
+                          size_t length);
+  static NodePtr MakeNode(const Node& node, NodePtr left, NodePtr right);
+  static NodePtr Merge(const NodePtr& left, const NodePtr& right);
+  // Merge that folds the two chunks meeting at the seam into a single leaf
+  // when together they fit in kChunkSize, so that small edits do not leave
+  // a trail of tiny leaves behind.
+  static NodePtr Join(const NodePtr& left, const NodePtr& right);
+  static NodePtr RemoveFirst(const NodePtr& node);
+  static NodePtr RemoveLast(const NodePtr& node);
+  static std::pair<NodePtr, NodePtr> Split(const NodePtr& node,
+                                           size_t position);
+  template <typename Callback>
+  static void VisitChunks(const Node* node, Callback& callback);
+};
+
+struct Rope::Node {
+  std::shared_ptr<const String> buffer;
+  size_t offset;
+  size_t chunk_length;
+  size_t length;
+  uint64_t priority;
+  NodePtr left;
+  NodePtr right;
+
+  StringView chunk() const { return {buffer->data() + offset, chunk_length}; }
+};
+
+template <typename Callback>
+void Rope::VisitChunks(const Node* node, Callback& callback) {
+  if (node == nullptr) {
+    return;
+  }
+  VisitChunks(node->left.get(), callback);
+  callback(node->chunk());
+  VisitChunks(node->right.get(), callback);
+}
+
+Rope operator+(const Rope& rope1, const Rope& rope2);
+std::ostream& operator<<(std::ostream& out, const Rope& rope);
@@ -0,0 +1,124 @@
+// Editing a large document with small inserts and erases at random
+// positions: Rope against rebuilding a String with concat and against
+// std::string::insert/erase. String is skipped (0 ms) past 1 MB. Not part
+// of any build; run it with
+//   g++ -std=c++20 -O2 string/rope_benchmark.cpp
+//       $(ls string/*.cpp | grep -v _benchmark) -o rope_bench && ./rope_bench
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "rope.h"
+
+namespace {
+
+const size_t kEdits = 20000;
+// Rebuilding a String per edit is quadratic; past this it takes minutes.
+const size_t kMaxRebuiltLength = size_t(1) << 20;
+
+struct Edit {
+  bool insert;
+  size_t position;
+  size_t length;
+};
+
+// Positions are drawn against the running length, so every implementation
+// applies exactly the same edits.
+std::vector<Edit> MakeEdits(size_t length) {
+  std::minstd_rand random(11);
+  std::vector<Edit> edits;
+  for (size_t i = 0; i < kEdits; ++i) {
+    Edit edit{random() % 4 != 0, 0, 1 + random() % 16};
+    if (!edit.insert) {
+      edit.length = std::min(edit.length, length);
+    }
+    edit.position = random() % (length - (edit.insert ? 0 : edit.length) + 1);
+    length += edit.insert ? edit.length : -edit.length;
+    edits.push_back(edit);
+  }
+  return edits;
+}
+
+const char kInserted[] = "0123456789abcdef";
+
+double Seconds(std::chrono::steady_clock::time_point start) {
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+void Expect(bool condition, const char* what) {
+  if (!condition) {
+    std::fprintf(stderr, "FAILED: %s\n", what);
+    std::exit(1);
+  }
+}
+
+void Compare(size_t document_length) {
+  std::string document(document_length, '.');
+  std::vector<Edit> edits = MakeEdits(document_length);
+
+  auto start = std::chrono::steady_clock::now();
+  Rope rope(StringView(document.data(), document.size()));
+  for (const Edit& edit : edits) {
+    if (edit.insert) {
+      rope.insert(edit.position, StringView(kInserted, edit.length));
+    } else {
+      rope.erase(edit.position, edit.length);
+    }
+  }
+  std::shared_ptr<const String> flat = rope.flatten();
+  double rope_seconds = Seconds(start);
+  size_t leaves = 0;
+  rope.for_each_chunk([&leaves](StringView) { ++leaves; });
+
+  double string_seconds = 0;
+  String string;
+  if (document_length <= kMaxRebuiltLength) {
+    start = std::chrono::steady_clock::now();
+    string = String(StringView(document.data(), document.size()));
+    for (const Edit& edit : edits) {
+      StringView view = string;
+      if (edit.insert) {
+        string = String::concat(view.substr(0, edit.position),
+                                StringView(kInserted, edit.length),
+                                view.substr(edit.position, view.length()));
+      } else {
+        string = String::concat(
+            view.substr(0, edit.position),
+            view.substr(edit.position + edit.length, view.length()));
+      }
+    }
+    string_seconds = Seconds(start);
+  }
+
+  start = std::chrono::steady_clock::now();
+  for (const Edit& edit : edits) {
+    if (edit.insert) {
+      document.insert(edit.position, kInserted, edit.length);
+    } else {
+      document.erase(edit.position, edit.length);
+    }
+  }
+  double std_seconds = Seconds(start);
+
+  Expect(StringView(*flat) == StringView(document.data(), document.size()),
+         "Rope and std::string agree");
+  Expect(document_length > kMaxRebuiltLength or StringView(*flat) == string,
+         "Rope and String agree");
+  std::printf("%10zu %8zu %10.1f %12.1f %12.1f\n", document_length, leaves,
+              rope_seconds * 1e3, string_seconds * 1e3, std_seconds * 1e3);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("%zu edits\n  document   leaves  Rope (ms)  String (ms)"
+              "  std (ms)\n", kEdits);
+  for (size_t document_length : {size_t(1) << 14, size_t(1) << 20,
+                                 size_t(1) << 24}) {
+    Compare(document_length);
+  }
+}
@@ -0,0 +1,77 @@
+// Heap allocations and time per operation for String and std::string on
+// short keys and tokens, where the small-string layout should not allocate.
+// Not part of any build; run it with
+//   g++ -std=c++20 -O2 string/sso_benchmark.cpp
+//       $(ls string/*.cpp | grep -v _benchmark) -o sso_bench && ./sso_bench
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "string.h"
+
+size_t allocation_count = 0;
+
+void* operator new(size_t size) {
+  ++allocation_count;
+  if (void* memory = std::malloc(size)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+
+namespace {
+
+const size_t kIterations = 1000000;
+const char kKey[] = "user:10482";
+const char kToken[] = "request_latency_ms_p99";
+const char kLong[] = "a line of log text that is well past any inline buffer";
+
+size_t sink = 0;
+
+template <typename Operation>
+void Measure(const char* name, Operation operation) {
+  size_t allocations_before = allocation_count;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < kIterations; ++i) {
+    sink += operation();
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::printf("%-34s %6.2f allocs/op %8.2f ns/op\n", name,
+              double(allocation_count - allocations_before) / kIterations,
+              elapsed.count() / kIterations);
+}
+
+template <typename StringType>
+void Workloads(const char* type) {
+  std::printf("%s\n", type);
+  Measure("  default construct", [] { return StringType().size(); });
+  Measure("  construct 10-byte key", [] { return StringType(kKey).size(); });
+  Measure("  construct 22-byte token",
+          [] { return StringType(kToken).size(); });
+  StringType token(kToken);
+  Measure("  copy 22-byte token", [&] { return StringType(token).size(); });
+  Measure("  push_back 16 characters", [] {
+    StringType built;
+    for (char symbol = 'a'; symbol < 'a' + 16; ++symbol) {
+      built.push_back(symbol);
+    }
+    return built.size();
+  });
+  Measure("  construct 55-byte line", [] { return StringType(kLong).size(); });
+}
+
+}  // namespace
+
+int main() {
+  Workloads<String>("String");
+  Workloads<std::string>("std::string");
+  std::printf("checksum %zu\n", sink);
+}
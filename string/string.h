@@ -1,55 +1,697 @@
+#pragma once
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cctype>
+#include <cstdarg>
 #include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include "string_number.h"
+#include "string_view.h"
+#include "utf8.h"
 
-class String {
+template <typename Allocator = std::allocator<char>>
+class BasicString {
  public:
-  String(const char* c_string);
-  String(size_t n, char symbol);
-  String();
-  String(const String& string);
-  String(char symbol);
-  ~String();
-  String& operator=(String string);
-  const char& operator[](size_t ind) const { return string_[ind]; }
-  char& operator[](size_t ind) { return string_[ind]; };
-  size_t length() const { return length_; };
-  size_t capacity() const { return capacity_; };
-  size_t size() const { return length_; };
+  using allocator_type = Allocator;
+
+  BasicString();
+  explicit BasicString(const Allocator& allocator);
+  BasicString(const char* c_string, const Allocator& allocator = Allocator());
+  BasicString(size_t n, char symbol, const Allocator& allocator = Allocator());
+  BasicString(const BasicString& string);
+  BasicString(const BasicString& string, const Allocator& allocator);
+  BasicString(BasicString&& string) noexcept;
+  BasicString(BasicString&& string, const Allocator& allocator);
+  BasicString(char symbol, const Allocator& allocator = Allocator());
+  explicit BasicString(StringView view,
+                       const Allocator& allocator = Allocator());
+  ~BasicString() { free_memory(); }
+  BasicString& operator=(const BasicString& string);
+  BasicString& operator=(BasicString&& string) noexcept(kNothrowMoveAssign);
+  template <typename... Pieces>
+  static BasicString concat(const Pieces&... pieces);
+  template <typename Iterator>
+  static BasicString join(Iterator first, Iterator last, StringView separator,
+                          const Allocator& allocator = Allocator());
+  template <typename Range>
+  static BasicString join(const Range& range, StringView separator,
+                          const Allocator& allocator = Allocator()) {
+    return join(std::begin(range), std::end(range), separator, allocator);
+  }
+  allocator_type get_allocator() const { return alloc_; }
+  const char& operator[](size_t ind) const { return data()[ind]; }
+  char& operator[](size_t ind) { return data()[ind]; };
+  size_t length() const;
+  size_t capacity() const;
+  size_t size() const { return length(); };
   void push_back(char symbol);
-  void pop_back() { --length_; };
-  char& front() { return string_[0]; };
-  const char& front() const { return string_[0]; };
-  char& back() { return string_[length_ - 1]; };
-  const char& back() const { return string_[length_ - 1]; };
-  String& operator+=(const String& string);
-  String& operator+=(char symbol);
-  size_t find(const String& substring) const;
-  size_t rfind(const String& substring) const;
-  String substr(size_t start, size_t count) const;
-  bool empty() const { return length_ == 0; };
+  void pop_back() { set_length(length() - 1); };
+  char& front() { return data()[0]; };
+  const char& front() const { return data()[0]; };
+  char& back() { return data()[length() - 1]; };
+  const char& back() const { return data()[length() - 1]; };
+  BasicString& operator+=(StringView view);
+  BasicString& operator+=(char symbol);
+  BasicString& append_int(int64_t value);
+  BasicString& append_uint(uint64_t value);
+  BasicString& append_double(double value);
+  BasicString& appendf(const char* format, ...)
+      __attribute__((format(printf, 2, 3)));
+  int64_t parse_int(size_t* consumed = nullptr) const {
+    return ParseInt(*this, consumed);
+  }
+  double parse_double(size_t* consumed = nullptr) const {
+    return ParseDouble(*this, consumed);
+  }
+  size_t find(StringView substring) const {
+    return StringView(*this).find(substring);
+  }
+  size_t find(char symbol) const { return StringView(*this).find(symbol); }
+  size_t rfind(StringView substring) const {
+    return StringView(*this).rfind(substring);
+  }
+  size_t rfind(char symbol) const { return StringView(*this).rfind(symbol); }
+  size_t find_first_of(StringView symbols) const {
+    return StringView(*this).find_first_of(symbols);
+  }
+  BasicString substr(size_t start, size_t count) const {
+    return BasicString(substr_view(start, count), alloc_);
+  }
+  StringView substr_view(size_t start, size_t count) const {
+    return StringView(data(), length()).substr(start, count);
+  }
+  bool is_valid_utf8() const { return IsValidUtf8(data(), length()); }
+  Utf8View code_points() const { return Utf8View(*this); }
+  void to_lower() { ToLowerAscii(data(), length()); }
+  void to_upper() { ToUpperAscii(data(), length()); }
+  bool empty() const { return length() == 0; };
   void clear();
+  void reserve(size_t new_capacity);
   void shrink_to_fit();
-  char* data() { return string_; };
-  const char* data() const { return string_; };
+  void share();
+  bool is_shared() const {
+    return static_cast<unsigned char>(small_[kSmallCapacity]) ==
+           kSharedCategory;
+  }
+  char* data() {
+    detach();
+    return is_small() ? small_ : heap_.string;
+  };
+  const char* data() const { return is_small() ? small_ : heap_.string; };
+  operator StringView() const { return {data(), length()}; }
 
  private:
-  size_t length_;
-  size_t capacity_;
-  char* string_;
+  using alloc_traits = std::allocator_traits<Allocator>;
+
+  struct HeapBuffer {
+    char* string;
+    size_t length;
+    size_t capacity;
+  };
+
+  struct SharedHeader {
+    std::atomic<size_t> references{1};
+  };
+
+  using header_traits =
+      typename alloc_traits::template rebind_traits<SharedHeader>;
+
+  static_assert(std::endian::native == std::endian::little,
+                "the category flag must live in the last byte of String");
+  static constexpr size_t kSmallCapacity = sizeof(HeapBuffer) - 1;
+  static constexpr size_t kHeapFlag = size_t(1) << (8 * sizeof(size_t) - 1);
+  static constexpr size_t kSharedFlag = kHeapFlag >> 1;
+  static constexpr unsigned char kHeapCategory = 0x80;
+  static constexpr unsigned char kSharedCategory = 0xC0;
+  static constexpr bool kNothrowMoveAssign =
+      alloc_traits::propagate_on_container_move_assignment::value or
+      alloc_traits::is_always_equal::value;
+
+  [[no_unique_address]] Allocator alloc_;
+  union {
+    HeapBuffer heap_;
+    char small_[sizeof(HeapBuffer)];
+  };
+
+  bool is_small() const {
+    return (static_cast<unsigned char>(small_[kSmallCapacity]) &
+            kHeapCategory) == 0;
+  }
+  void init(const char* source, size_t length);
+  void init_copy(const BasicString& string);
+  void detach() {
+    if (is_shared()) {
+      BasicString copy(StringView(*this), alloc_);
+      swap(copy);
+    }
+  }
+  SharedHeader* shared_header() const {
+    return reinterpret_cast<SharedHeader*>(heap_.string) - 1;
+  }
+  static size_t shared_header_count(size_t capacity) {
+    return 1 + (capacity + sizeof(SharedHeader)) / sizeof(SharedHeader);
+  }
+  void set_length(size_t new_length);
+  void free_memory();
+  void swap(BasicString& string);
+};
+
+using String = BasicString<>;
+
+template <typename Allocator>
+BasicString<Allocator>::BasicString() {
+  init("", 0);
+}
+
+template <typename Allocator>
+BasicString<Allocator>::BasicString(const Allocator& allocator)
+    : alloc_(allocator) {
+  init("", 0);
+}
+
+template <typename Allocator>
+BasicString<Allocator>::BasicString(const char* c_string,
+                                    const Allocator& allocator)
+    : alloc_(allocator) {
+  init(c_string, strlen(c_string));
+}
+
+template <typename Allocator>
+BasicString<Allocator>::BasicString(size_t n, char symbol,
+                                    const Allocator& allocator)
+    : alloc_(allocator) {
+  init("", 0);
+  reserve(n);
+  std::fill(data(), data() + n, symbol);
+  set_length(n);
+}
+
+template <typename Allocator>
+BasicString<Allocator>::BasicString(const BasicString& string)
+    : alloc_(alloc_traits::select_on_container_copy_construction(
+          string.alloc_)) {
+  init_copy(string);
+}
+
+template <typename Allocator>
+BasicString<Allocator>::BasicString(const BasicString& string,
+                                    const Allocator& allocator)
+    : alloc_(allocator) {
+  init_copy(string);
+}
+
+template <typename Allocator>
+BasicString<Allocator>::BasicString(BasicString&& string) noexcept
+    : alloc_(std::move(string.alloc_)) {
+  std::copy(string.small_, string.small_ + sizeof(small_), small_);
+  string.init("", 0);
+}
+
+template <typename Allocator>
+BasicString<Allocator>::BasicString(BasicString&& string,
+                                    const Allocator& allocator)
+    : alloc_(allocator) {
+  if (alloc_traits::is_always_equal::value or alloc_ == string.alloc_) {
+    std::copy(string.small_, string.small_ + sizeof(small_), small_);
+    string.init("", 0);
+  } else {
+    init_copy(string);
+  }
+}
+
+template <typename Allocator>
+BasicString<Allocator>::BasicString(char symbol, const Allocator& allocator)
+    : alloc_(allocator) {
+  init(&symbol, 1);
+}
+
+template <typename Allocator>
+BasicString<Allocator>::BasicString(StringView view,
+                                    const Allocator& allocator)
+    : alloc_(allocator) {
+  init(view.data(), view.length());
+}
+
+template <typename Allocator>
+BasicString<Allocator>& BasicString<Allocator>::operator=(
+    const BasicString& string) {
+  if (this == &string) {
+    return *this;
+  }
+  if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+    if (alloc_ != string.alloc_) {
+      BasicString copy(string, string.alloc_);
+      swap(copy);
+      return *this;
+    }
+  }
+  size_t new_length = string.length();
+  if (is_shared() or string.is_shared() or capacity() < new_length) {
+    BasicString copy(string, alloc_);
+    swap(copy);
+  } else {
+    std::copy(string.data(), string.data() + new_length, data());
+    set_length(new_length);
+  }
+  return *this;
+}
+
+template <typename Allocator>
+BasicString<Allocator>& BasicString<Allocator>::operator=(
+    BasicString&& string) noexcept(kNothrowMoveAssign) {
+  Allocator alloc_copy = alloc_;
+  if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+    alloc_copy = string.alloc_;
+  }
+  BasicString moved(std::move(string), alloc_copy);
+  swap(moved);
+  return *this;
+}
+
+template <typename Allocator>
+template <typename... Pieces>
+BasicString<Allocator> BasicString<Allocator>::concat(
+    const Pieces&... pieces) {
+  std::array<StringView, sizeof...(Pieces)> views{StringView(pieces)...};
+  return join(views.begin(), views.end(), StringView());
+}
+
+template <typename Allocator>
+template <typename Iterator>
+BasicString<Allocator> BasicString<Allocator>::join(
+    Iterator first, Iterator last, StringView separator,
+    const Allocator& allocator) {
+  BasicString result(allocator);
+  if (first == last) {
+    return result;
+  }
+  size_t total = 0;
+  size_t count = 0;
+  for (Iterator it = first; it != last; ++it, ++count) {
+    total += StringView(*it).length();
+  }
+  total += (count - 1) * separator.length();
+  result.reserve(total);
+  char* out = result.data();
+  for (Iterator it = first; it != last; ++it) {
+    if (it != first) {
+      out = std::copy(separator.begin(), separator.end(), out);
+    }
+    StringView piece(*it);
+    out = std::copy(piece.begin(), piece.end(), out);
+  }
+  result.set_length(total);
+  return result;
+}
+
+template <typename Allocator>
+size_t BasicString<Allocator>::length() const {
+  if (is_small()) {
+    return kSmallCapacity - static_cast<size_t>(small_[kSmallCapacity]);
+  }
+  return heap_.length;
+}
+
+template <typename Allocator>
+size_t BasicString<Allocator>::capacity() const {
+  return is_small() ? kSmallCapacity
+                    : heap_.capacity & ~(kHeapFlag | kSharedFlag);
+}
+
+template <typename Allocator>
+void BasicString<Allocator>::push_back(char symbol) {
+  size_t old_length = length();
+  if (capacity() == old_length) {
+    reserve(2 * capacity());
+  }
+  data()[old_length] = symbol;
+  set_length(old_length + 1);
+}
+
+template <typename Allocator>
+BasicString<Allocator>& BasicString<Allocator>::operator+=(StringView view) {
+  size_t old_length = length();
+  size_t new_length = old_length + view.length();
+  if (capacity() < new_length) {
+    BasicString grown(alloc_);
+    grown.reserve(std::max(2 * capacity(), new_length));
+    std::copy_n(std::as_const(*this).data(), old_length, grown.data());
+    std::copy(view.begin(), view.end(), grown.data() + old_length);
+    grown.set_length(new_length);
+    swap(grown);
+  } else {
+    std::copy(view.begin(), view.end(), data() + old_length);
+    set_length(new_length);
+  }
+  return *this;
+}
+
+template <typename Allocator>
+BasicString<Allocator>& BasicString<Allocator>::operator+=(char symbol) {
+  push_back(symbol);
+  return *this;
+}
+
+template <typename Allocator>
+BasicString<Allocator>& BasicString<Allocator>::append_int(int64_t value) {
+  size_t old_length = length();
+  reserve(old_length + kMaxIntLength);
+  set_length(old_length + FormatInt(value, data() + old_length));
+  return *this;
+}
+
+template <typename Allocator>
+BasicString<Allocator>& BasicString<Allocator>::append_uint(uint64_t value) {
+  size_t old_length = length();
+  reserve(old_length + kMaxIntLength);
+  set_length(old_length + FormatUInt(value, data() + old_length));
+  return *this;
+}
+
+template <typename Allocator>
+BasicString<Allocator>& BasicString<Allocator>::append_double(double value) {
+  size_t old_length = length();
+  reserve(old_length + kMaxDoubleLength);
+  set_length(old_length + FormatDouble(value, data() + old_length));
+  return *this;
+}
+
+template <typename Allocator>
+BasicString<Allocator>& BasicString<Allocator>::appendf(const char* format,
+                                                        ...) {
+  size_t old_length = length();
+  size_t room = capacity() - old_length;
+  va_list args;
+  va_list args_copy;
+  va_start(args, format);
+  va_copy(args_copy, args);
+  int written = std::vsnprintf(data() + old_length, room + 1, format, args);
+  va_end(args);
+  if (written < 0) {
+    va_end(args_copy);
+    set_length(old_length);
+    throw std::runtime_error("Bad format string");
+  }
+  auto added = static_cast<size_t>(written);
+  if (added > room) {
+    set_length(old_length);
+    reserve(std::max(2 * capacity(), old_length + added));
+    std::vsnprintf(data() + old_length, added + 1, format, args_copy);
+  }
+  va_end(args_copy);
+  set_length(old_length + added);
+  return *this;
+}
+
+template <typename Allocator>
+void BasicString<Allocator>::clear() {
+  if (is_shared()) {
+    BasicString empty(alloc_);
+    swap(empty);
+  } else {
+    set_length(0);
+  }
+}
+
+template <typename Allocator>
+void BasicString<Allocator>::reserve(size_t new_capacity) {
+  if (new_capacity <= capacity()) {
+    return;
+  }
+  size_t old_length = length();
+  char* new_memory = alloc_traits::allocate(alloc_, new_capacity + 1);
+  std::copy_n(std::as_const(*this).data(), old_length + 1, new_memory);
+  free_memory();
+  heap_.string = new_memory;
+  heap_.length = old_length;
+  heap_.capacity = new_capacity | kHeapFlag;
+}
+
+template <typename Allocator>
+void BasicString<Allocator>::shrink_to_fit() {
+  if (!is_small() and !is_shared() and capacity() > length()) {
+    BasicString new_string(StringView(*this), alloc_);
+    swap(new_string);
+  }
+}
+
+// Moves a heap buffer behind an atomic reference count so that later copies
+// share it; the first mutation through any copy detaches that copy. Inline
+// strings are already cheap to copy and stay as they are.
+template <typename Allocator>
+void BasicString<Allocator>::share() {
+  if (is_small() or is_shared()) {
+    return;
+  }
+  size_t old_length = length();
+  typename header_traits::allocator_type header_alloc(alloc_);
+  SharedHeader* header =
+      header_traits::allocate(header_alloc, shared_header_count(old_length));
+  header_traits::construct(header_alloc, header);
+  char* shared = reinterpret_cast<char*>(header + 1);
+  std::copy_n(heap_.string, old_length + 1, shared);
+  free_memory();
+  heap_.string = shared;
+  heap_.length = old_length;
+  heap_.capacity = old_length | kHeapFlag | kSharedFlag;
+}
+
+template <typename Allocator>
+void BasicString<Allocator>::init(const char* source, size_t length) {
+  if (length <= kSmallCapacity) {
+    std::copy(source, source + length, small_);
+    small_[length] = '\0';
+    small_[kSmallCapacity] = static_cast<char>(kSmallCapacity - length);
+  } else {
+    heap_.string = alloc_traits::allocate(alloc_, length + 1);
+    std::copy(source, source + length, heap_.string);
+    heap_.string[length] = '\0';
+    heap_.length = length;
+    heap_.capacity = length | kHeapFlag;
+  }
+}
+
+template <typename Allocator>
+void BasicString<Allocator>::init_copy(const BasicString& string) {
+  if (string.is_shared() and alloc_ == string.alloc_) {
+    string.shared_header()->references.fetch_add(1,
+                                                 std::memory_order_relaxed);
+    std::copy(string.small_, string.small_ + sizeof(small_), small_);
+  } else {
+    init(string.data(), string.length());
+  }
+}
+
+template <typename Allocator>
+void BasicString<Allocator>::set_length(size_t new_length) {
+  detach();
+  if (is_small()) {
+    small_[new_length] = '\0';
+    small_[kSmallCapacity] = static_cast<char>(kSmallCapacity - new_length);
+  } else {
+    heap_.string[new_length] = '\0';
+    heap_.length = new_length;
+  }
+}
+
+template <typename Allocator>
+void BasicString<Allocator>::free_memory() {
+  if (is_shared()) {
+    SharedHeader* header = shared_header();
+    if (header->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      typename header_traits::allocator_type header_alloc(alloc_);
+      header_traits::destroy(header_alloc, header);
+      header_traits::deallocate(header_alloc, header,
+                                shared_header_count(capacity()));
+    }
+  } else if (!is_small()) {
+    alloc_traits::deallocate(alloc_, heap_.string, capacity() + 1);
+  }
+}
+
+template <typename Allocator>
+void BasicString<Allocator>::swap(BasicString& string) {
+  std::swap(alloc_, string.alloc_);
+  std::swap(small_, string.small_);
+}
+
+template <typename Allocator>
+BasicString<Allocator> operator+(const BasicString<Allocator>& string,
+                                 StringView view) {
+  BasicString<Allocator> result(string.get_allocator());
+  result.reserve(string.length() + view.length());
+  result += string;
+  result += view;
+  return result;
+}
+
+template <typename Allocator>
+BasicString<Allocator> operator+(BasicString<Allocator>&& string,
+                                 StringView view) {
+  string += view;
+  return std::move(string);
+}
+
+template <typename Allocator>
+BasicString<Allocator> operator+(const BasicString<Allocator>& string1,
+                                 const BasicString<Allocator>& string2) {
+  return string1 + StringView(string2);
+}
+
+template <typename Allocator>
+BasicString<Allocator> operator+(BasicString<Allocator>&& string1,
+                                 const BasicString<Allocator>& string2) {
+  return std::move(string1) + StringView(string2);
+}
+
+template <typename Allocator>
+BasicString<Allocator> operator+(const BasicString<Allocator>& string1,
+                                 BasicString<Allocator>&& string2) {
+  return StringView(string1) + std::move(string2);
+}
+
+template <typename Allocator>
+BasicString<Allocator> operator+(BasicString<Allocator>&& string1,
+                                 BasicString<Allocator>&& string2) {
+  return std::move(string1) + StringView(string2);
+}
+
+template <typename Allocator>
+BasicString<Allocator> operator+(StringView view,
+                                 const BasicString<Allocator>& string) {
+  BasicString<Allocator> result(string.get_allocator());
+  result.reserve(view.length() + string.length());
+  result += view;
+  result += string;
+  return result;
+}
+
+// Appends and rotates, so the string's own buffer is reused when it fits.
+template <typename Allocator>
+BasicString<Allocator> operator+(StringView view,
+                                 BasicString<Allocator>&& string) {
+  size_t length = string.length();
+  string += view;
+  char* data = string.data();
+  std::rotate(data, data + length, data + string.length());
+  return std::move(string);
+}
+
+template <typename Allocator>
+BasicString<Allocator> operator+(char symbol,
+                                 const BasicString<Allocator>& string) {
+  return StringView(&symbol, 1) + string;
+}
+
+template <typename Allocator>
+BasicString<Allocator> operator+(char symbol,
+                                 BasicString<Allocator>&& string) {
+  return StringView(&symbol, 1) + std::move(string);
+}
+
+template <typename Allocator>
+BasicString<Allocator> operator+(const BasicString<Allocator>& string,
+                                 char symbol) {
+  return string + StringView(&symbol, 1);
+}
+
+template <typename Allocator>
+BasicString<Allocator> operator+(BasicString<Allocator>&& string,
+                                 char symbol) {
+  string += symbol;
+  return std::move(string);
+}
+
+template <typename Allocator>
+std::ostream& operator<<(std::ostream& out,
+                         const BasicString<Allocator>& string) {
+  return out << StringView(string);
+}
+
+template <typename Allocator>
+std::istream& operator>>(std::istream& flow_in,
+                         BasicString<Allocator>& string) {
+  using Traits = std::char_traits<char>;
+  const int kEof = Traits::eof();
+  const size_t kStreamChunk = 256;
+  string.clear();
+  std::istream::sentry sentry(flow_in, true);
+  if (!sentry) {
+    return flow_in;
+  }
+  std::streambuf* buffer = flow_in.rdbuf();
+  int symbol = buffer->sgetc();
+  while (symbol != kEof and IsSpace(Traits::to_char_type(symbol))) {
+    symbol = buffer->snextc();
+  }
+  char chunk[kStreamChunk];
+  size_t filled = 0;
+  while (symbol != kEof and !IsSpace(Traits::to_char_type(symbol))) {
+    chunk[filled++] = Traits::to_char_type(symbol);
+    if (filled == kStreamChunk) {
+      string += StringView(chunk, filled);
+      filled = 0;
+    }
+    symbol = buffer->snextc();
+  }
+  string += StringView(chunk, filled);
+  if (symbol == kEof) {
+    flow_in.setstate(std::ios_base::eofbit);
+  }
+  if (string.empty()) {
+    flow_in.setstate(std::ios_base::failbit);
+  }
+  return flow_in;
+}
+
+template <typename Allocator>
+std::istream& getline(std::istream& flow_in, BasicString<Allocator>& string,
+                      char delimiter = '\n') {
+  using Traits = std::char_traits<char>;
+  const int kEof = Traits::eof();
+  const size_t kStreamChunk = 256;
+  string.clear();
+  std::istream::sentry sentry(flow_in, true);
+  if (!sentry) {
+    return flow_in;
+  }
+  std::streambuf* buffer = flow_in.rdbuf();
+  char chunk[kStreamChunk];
+  size_t filled = 0;
+  bool extracted = false;
+  while (true) {
+    int symbol = buffer->sbumpc();
+    if (symbol == kEof) {
+      flow_in.setstate(extracted ? std::ios_base::eofbit
+                                 : std::ios_base::eofbit |
+                                       std::ios_base::failbit);
+      break;
+    }
+    extracted = true;
+    if (Traits::to_char_type(symbol) == delimiter) {
+      break;
+    }
+    chunk[filled++] = Traits::to_char_type(symbol);
+    if (filled == kStreamChunk) {
+      string += StringView(chunk, filled);
+      filled = 0;
+    }
+  }
+  string += StringView(chunk, filled);
+  return flow_in;
+}
 
-  void swap(String& string);
-  void reserve(size_t new_size);
+template <typename Allocator>
+struct std::hash<BasicString<Allocator>> {
+  size_t operator()(const BasicString<Allocator>& string) const {
+    return std::hash<StringView>()(string);
+  }
 };
 
-bool operator==(const String& string1, const String& string2);
-bool operator!=(const String& string1, const String& string2);
-bool operator<(const String& string1, const String& string2);
-bool operator>(const String& string1, const String& string2);
-bool operator<=(const String& string1, const String& string2);
-bool operator>=(const String& string1, const String& string2);
-String operator+(String string1, const String& string2);
-std::ostream& operator<<(std::ostream& out, const String& string);
-std::istream& operator>>(std::istream& flow_in, String& string);
\ No newline at end of file
+extern template class BasicString<>;
@@ -0,0 +1,30 @@
+#pragma once
+#include <vector>
+#include "string.h"
+
+// Pieces are kept as views, so the bytes they refer to must outlive build().
+class StringBuilder {
+ public:
+  StringBuilder& append(StringView piece) {
+    pieces_.push_back(piece);
+    length_ += piece.length();
+    return *this;
+  }
+  template <typename Allocator>
+  StringBuilder& append(BasicString<Allocator>&& piece) = delete;
+  [[nodiscard]] size_t length() const { return length_; }
+  [[nodiscard]] bool empty() const { return length_ == 0; }
+  void clear() {
+    pieces_.clear();
+    length_ = 0;
+  }
+  template <typename Allocator = std::allocator<char>>
+  BasicString<Allocator> build(const Allocator& allocator = Allocator()) const {
+    return BasicString<Allocator>::join(pieces_.begin(), pieces_.end(),
+                                        StringView(), allocator);
+  }
+
+ private:
+  std::vector<StringView> pieces_;
+  size_t length_ = 0;
+};
@@ -0,0 +1,94 @@
+#include "string_hash.h"
+#include <cstring>
+
+namespace {
+
+const uint64_t kSecret[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL,
+                             0x4b33a62ed433d4a3ULL, 0x4d5a2da51de1aa47ULL};
+
+void Multiply(uint64_t& low, uint64_t& high) {
+#ifdef __SIZEOF_INT128__
+  __uint128_t product = static_cast<__uint128_t>(low) * high;
+  low = static_cast<uint64_t>(product);
+  high = static_cast<uint64_t>(product >> 64);
+#else
+  uint64_t low_low = (low & 0xFFFFFFFF) * (high & 0xFFFFFFFF);
+  uint64_t low_high = (low & 0xFFFFFFFF) * (high >> 32);
+  uint64_t high_low = (low >> 32) * (high & 0xFFFFFFFF);
+  uint64_t high_high = (low >> 32) * (high >> 32);
+  uint64_t middle = (low_low >> 32) + (low_high & 0xFFFFFFFF) +
+                    (high_low & 0xFFFFFFFF);
+  low = (low_low & 0xFFFFFFFF) | (middle << 32);
+  high = high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+#endif
+}
+
+uint64_t Mix(uint64_t first, uint64_t second) {
+  Multiply(first, second);
+  return first ^ second;
+}
+
+uint64_t Read8(const char* data) {
+  uint64_t result;
+  std::memcpy(&result, data, sizeof(result));
+  return result;
+}
+
+uint64_t Read4(const char* data) {
+  uint32_t result;
+  std::memcpy(&result, data, sizeof(result));
+  return result;
+}
+
+uint64_t Read3(const char* data, size_t length) {
+  return (static_cast<uint64_t>(static_cast<unsigned char>(data[0])) << 16) |
+         (static_cast<uint64_t>(static_cast<unsigned char>(data[length / 2]))
+          << 8) |
+         static_cast<unsigned char>(data[length - 1]);
+}
+
+}  // namespace
+
+uint64_t HashBytes(const char* data, size_t length, uint64_t seed) {
+  seed ^= Mix(seed ^ kSecret[0], kSecret[1]);
+  uint64_t first = 0;
+  uint64_t second = 0;
+  if (length <= 16) {
+    if (length >= 4) {
+      size_t offset = (length / 8) * 4;
+      first = (Read4(data) << 32) | Read4(data + offset);
+      second = (Read4(data + length - 4) << 32) |
+               Read4(data + length - 4 - offset);
+    } else if (length > 0) {
+      first = Read3(data, length);
+    }
+  } else {
+    const char* current = data;
+    size_t rest = length;
+    if (rest > 48) {
+      uint64_t lane1 = seed;
+      uint64_t lane2 = seed;
+      do {
+        seed = Mix(Read8(current) ^ kSecret[1], Read8(current + 8) ^ seed);
+        lane1 = Mix(Read8(current + 16) ^ kSecret[2],
+                    Read8(current + 24) ^ lane1);
+        lane2 = Mix(Read8(current + 32) ^ kSecret[3],
+                    Read8(current + 40) ^ lane2);
+        current += 48;
+        rest -= 48;
+      } while (rest > 48);
+      seed ^= lane1 ^ lane2;
+    }
+    while (rest > 16) {
+      seed = Mix(Read8(current) ^ kSecret[1], Read8(current + 8) ^ seed);
+      current += 16;
+      rest -= 16;
+    }
+    first = Read8(current + rest - 16);
+    second = Read8(current + rest - 8);
+  }
+  first ^= kSecret[1];
+  second ^= seed;
+  Multiply(first, second);
+  return Mix(first ^ kSecret[0] ^ length, second ^ kSecret[1]);
+}
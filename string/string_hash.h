@@ -0,0 +1,5 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+uint64_t HashBytes(const char* data, size_t length, uint64_t seed = 0);
@@ -0,0 +1,92 @@
+#include "string_number.h"
+#include <charconv>
+#include <stdexcept>
+#include <system_error>
+
+namespace {
+
+const char kDigitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+size_t CountDigits(uint64_t value) {
+  size_t count = 1;
+  while (value >= 10000) {
+    value /= 10000;
+    count += 4;
+  }
+  if (value >= 1000) {
+    return count + 3;
+  }
+  if (value >= 100) {
+    return count + 2;
+  }
+  return value >= 10 ? count + 1 : count;
+}
+
+template <typename T>
+T CheckParsed(std::from_chars_result result, const char* begin, T value,
+              size_t* consumed) {
+  if (result.ec == std::errc::invalid_argument) {
+    throw std::invalid_argument("Nothing to parse here");
+  }
+  if (result.ec == std::errc::result_out_of_range) {
+    throw std::out_of_range("The number does not fit");
+  }
+  if (consumed != nullptr) {
+    *consumed = result.ptr - begin;
+  }
+  return value;
+}
+
+}  // namespace
+
+size_t FormatUInt(uint64_t value, char* out) {
+  size_t length = CountDigits(value);
+  char* current = out + length;
+  while (value >= 100) {
+    size_t pair = 2 * (value % 100);
+    value /= 100;
+    *--current = kDigitPairs[pair + 1];
+    *--current = kDigitPairs[pair];
+  }
+  if (value >= 10) {
+    *--current = kDigitPairs[2 * value + 1];
+    *--current = kDigitPairs[2 * value];
+  } else {
+    *--current = static_cast<char>('0' + value);
+  }
+  return length;
+}
+
+size_t FormatInt(int64_t value, char* out) {
+  if (value >= 0) {
+    return FormatUInt(static_cast<uint64_t>(value), out);
+  }
+  *out = '-';
+  return 1 + FormatUInt(0 - static_cast<uint64_t>(value), out + 1);
+}
+
+size_t FormatDouble(double value, char* out) {
+  return std::to_chars(out, out + kMaxDoubleLength, value).ptr - out;
+}
+
+int64_t ParseInt(StringView text, size_t* consumed) {
+  int64_t value = 0;
+  auto result = std::from_chars(text.begin(), text.end(), value);
+  return CheckParsed(result, text.begin(), value, consumed);
+}
+
+double ParseDouble(StringView text, size_t* consumed) {
+  double value = 0;
+  auto result = std::from_chars(text.begin(), text.end(), value);
+  return CheckParsed(result, text.begin(), value, consumed);
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "string_view.h"
+
+const size_t kMaxIntLength = 20;
+const size_t kMaxDoubleLength = 24;
+
+size_t FormatUInt(uint64_t value, char* out);
+size_t FormatInt(int64_t value, char* out);
+size_t FormatDouble(double value, char* out);
+int64_t ParseInt(StringView text, size_t* consumed);
+double ParseDouble(StringView text, size_t* consumed);
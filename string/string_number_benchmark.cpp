@@ -0,0 +1,160 @@
+// Formatting and parsing throughput of String::append_int/append_double and
+// parse_int/parse_double against std::to_chars/from_chars, snprintf/strtod
+// and std::to_string, all writing into (or reading from) a String. Not part
+// of any build; run it with
+//   g++ -std=c++20 -O2 string/string_number_benchmark.cpp
+//       $(ls string/*.cpp | grep -v _benchmark) -o number_bench
+//   ./number_bench
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "string.h"
+
+namespace {
+
+const size_t kValues = 1000000;
+const size_t kFlushEvery = 1000;
+
+size_t sink = 0;
+
+template <typename Value, typename Append>
+void MeasureFormat(const char* name, const std::vector<Value>& values,
+                   Append append) {
+  String out;
+  out.reserve(kFlushEvery * 32);
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < values.size(); ++i) {
+    append(out, values[i]);
+    out += ' ';
+    if (i % kFlushEvery == kFlushEvery - 1) {
+      sink += out.length();
+      out.clear();
+    }
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::printf("  %-28s %7.1f ns/value\n", name,
+              elapsed.count() / values.size());
+}
+
+template <typename Value, typename Parse>
+void MeasureParse(const char* name, const std::vector<String>& texts,
+                  const std::vector<Value>& expected, Parse parse) {
+  auto start = std::chrono::steady_clock::now();
+  Value total = 0;
+  for (const String& text : texts) {
+    total += parse(text);
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  sink += static_cast<size_t>(total);
+  for (size_t i = 0; i < texts.size(); i += 997) {
+    if (parse(texts[i]) != expected[i]) {
+      std::fprintf(stderr, "FAILED: %s on %s\n", name, texts[i].data());
+      std::exit(1);
+    }
+  }
+  std::printf("  %-28s %7.1f ns/value\n", name,
+              elapsed.count() / texts.size());
+}
+
+template <typename Value>
+std::vector<String> Format(const std::vector<Value>& values) {
+  std::vector<String> texts;
+  for (Value value : values) {
+    String text;
+    if constexpr (std::is_floating_point_v<Value>) {
+      text.append_double(value);
+    } else {
+      text.append_int(value);
+    }
+    texts.push_back(std::move(text));
+  }
+  return texts;
+}
+
+}  // namespace
+
+int main() {
+  std::mt19937_64 random(9);
+  std::vector<int64_t> ints;
+  std::vector<double> doubles;
+  for (size_t i = 0; i < kValues; ++i) {
+    // Metric-like magnitudes: mostly small counters, some large ids.
+    int digits = 1 + static_cast<int>(random() % 18);
+    int64_t value = static_cast<int64_t>(random() % 1000000000000000000ULL);
+    for (int j = digits; j < 18; ++j) {
+      value /= 10;
+    }
+    ints.push_back(random() % 8 == 0 ? -value : value);
+    doubles.push_back(std::ldexp(static_cast<double>(random() >> 11),
+                                 static_cast<int>(random() % 80) - 90));
+  }
+
+  std::printf("int64 formatting into String\n");
+  MeasureFormat("append_int", ints,
+                [](String& out, int64_t value) { out.append_int(value); });
+  MeasureFormat("std::to_chars", ints, [](String& out, int64_t value) {
+    char buffer[24];
+    char* end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+    out += StringView(buffer, end - buffer);
+  });
+  MeasureFormat("snprintf %lld", ints, [](String& out, int64_t value) {
+    char buffer[24];
+    int length = std::snprintf(buffer, sizeof(buffer), "%lld",
+                               static_cast<long long>(value));
+    out += StringView(buffer, length);
+  });
+  MeasureFormat("std::to_string", ints, [](String& out, int64_t value) {
+    std::string text = std::to_string(value);
+    out += StringView(text.data(), text.size());
+  });
+
+  std::printf("double formatting into String (shortest round trip)\n");
+  MeasureFormat("append_double", doubles,
+                [](String& out, double value) { out.append_double(value); });
+  MeasureFormat("std::to_chars", doubles, [](String& out, double value) {
+    char buffer[32];
+    char* end = std::to_chars(buffer, buffer + sizeof(buffer), value).ptr;
+    out += StringView(buffer, end - buffer);
+  });
+  MeasureFormat("snprintf %.17g", doubles, [](String& out, double value) {
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    out += StringView(buffer, length);
+  });
+
+  std::vector<String> int_texts = Format(ints);
+  std::vector<String> double_texts = Format(doubles);
+  std::printf("int64 parsing from String\n");
+  MeasureParse("parse_int", int_texts, ints,
+               [](const String& text) { return text.parse_int(); });
+  MeasureParse("std::from_chars", int_texts, ints, [](const String& text) {
+    int64_t value = 0;
+    std::from_chars(text.data(), text.data() + text.length(), value);
+    return value;
+  });
+  MeasureParse("strtoll", int_texts, ints, [](const String& text) {
+    return static_cast<int64_t>(std::strtoll(text.data(), nullptr, 10));
+  });
+  std::printf("double parsing from String\n");
+  MeasureParse("parse_double", double_texts, doubles,
+               [](const String& text) { return text.parse_double(); });
+  MeasureParse("std::from_chars", double_texts, doubles,
+               [](const String& text) {
+    double value = 0;
+    std::from_chars(text.data(), text.data() + text.length(), value);
+    return value;
+  });
+  MeasureParse("strtod", double_texts, doubles, [](const String& text) {
+    return std::strtod(text.data(), nullptr);
+  });
+  std::printf("checksum %zu\n", sink);
+}
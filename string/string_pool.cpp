@@ -0,0 +1,128 @@
+#include "string_pool.h"
+
+const char* InternedString::data() const {
+  return entry_ == nullptr ? "" : entry_->data();
+}
+
+size_t InternedString::length() const {
+  return entry_ == nullptr ? 0 : entry_->length;
+}
+
+StringPool::Table::Table(size_t slot_count)
+    : mask(slot_count - 1),
+      slots(new std::atomic<const Entry*>[slot_count]) {
+  for (size_t i = 0; i < slot_count; ++i) {
+    slots[i].store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+StringPool::StringPool() {
+  for (Shard& shard : shards_) {
+    shard.tables.push_back(std::make_unique<Table>(kInitialSlots));
+    shard.table.store(shard.tables.back().get(), std::memory_order_release);
+  }
+}
+
+StringPool::~StringPool() {
+  for (Shard& shard : shards_) {
+    const Table* table = shard.table.load(std::memory_order_relaxed);
+    for (size_t i = 0; i <= table->mask; ++i) {
+      const Entry* entry = table->slots[i].load(std::memory_order_relaxed);
+      if (entry != nullptr) {
+        ::operator delete(const_cast<Entry*>(entry));
+      }
+    }
+  }
+}
+
+InternedString StringPool::intern(StringView text) {
+  intern_calls_.fetch_add(1, std::memory_order_relaxed);
+  if (text.empty()) {
+    return InternedString();
+  }
+  uint64_t hash = HashBytes(text.data(), text.length());
+  Shard& shard = shards_[hash >> (64 - kShardBits)];
+  const Entry* entry =
+      Find(*shard.table.load(std::memory_order_acquire), text, hash);
+  if (entry == nullptr) {
+    entry = insert(shard, text, hash);
+  } else {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    saved_bytes_.fetch_add(text.length() + 1, std::memory_order_relaxed);
+  }
+  return InternedString(entry);
+}
+
+StringPool::Statistics StringPool::statistics() const {
+  return {unique_strings_.load(std::memory_order_relaxed),
+          unique_bytes_.load(std::memory_order_relaxed),
+          intern_calls_.load(std::memory_order_relaxed),
+          hits_.load(std::memory_order_relaxed),
+          saved_bytes_.load(std::memory_order_relaxed)};
+}
+
+const StringPool::Entry* StringPool::Find(const Table& table, StringView text,
+                                          uint64_t hash) {
+  for (size_t slot = hash & table.mask;; slot = (slot + 1) & table.mask) {
+    const Entry* entry = table.slots[slot].load(std::memory_order_acquire);
+    if (entry == nullptr) {
+      return nullptr;
+    }
+    if (entry->hash == hash and
+        StringView(entry->data(), entry->length) == text) {
+      return entry;
+    }
+  }
+}
+
+void StringPool::Place(const Table& table, const Entry* entry) {
+  size_t slot = entry->hash & table.mask;
+  while (table.slots[slot].load(std::memory_order_relaxed) != nullptr) {
+    slot = (slot + 1) & table.mask;
+  }
+  table.slots[slot].store(entry, std::memory_order_release);
+}
+
+const StringPool::Entry* StringPool::MakeEntry(StringView text,
+                                               uint64_t hash) {
+  void* memory = ::operator new(sizeof(Entry) + text.length() + 1);
+  auto* entry = new (memory) Entry{hash, text.length()};
+  char* data = reinterpret_cast<char*>(entry + 1);
+  std::copy(text.begin(), text.end(), data);
+  data[text.length()] = '\0';
+  return entry;
+}
+
+const StringPool::Entry* StringPool::insert(Shard& shard, StringView text,
+                                            uint64_t hash) {
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  const Entry* entry =
+      Find(*shard.table.load(std::memory_order_relaxed), text, hash);
+  if (entry != nullptr) {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    saved_bytes_.fetch_add(text.length() + 1, std::memory_order_relaxed);
+    return entry;
+  }
+  if (2 * (shard.count + 1) > shard.tables.back()->mask + 1) {
+    grow(shard);
+  }
+  entry = MakeEntry(text, hash);
+  Place(*shard.tables.back(), entry);
+  ++shard.count;
+  unique_strings_.fetch_add(1, std::memory_order_relaxed);
+  unique_bytes_.fetch_add(text.length() + 1, std::memory_order_relaxed);
+  return entry;
+}
+
+void StringPool::grow(Shard& shard) {
+  const Table& old_table = *shard.tables.back();
+  auto new_table = std::make_unique<Table>(2 * (old_table.mask + 1));
+  for (size_t i = 0; i <= old_table.mask; ++i) {
+    const Entry* entry = old_table.slots[i].load(std::memory_order_relaxed);
+    if (entry != nullptr) {
+      Place(*new_table, entry);
+    }
+  }
+  shard.table.store(new_table.get(), std::memory_order_release);
+  shard.tables.push_back(std::move(new_table));
+}
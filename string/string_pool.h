@@ -0,0 +1,101 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "string.h"
+
+class InternedString {
+ public:
+  InternedString() = default;
+  [[nodiscard]] const char* data() const;
+  [[nodiscard]] size_t length() const;
+  [[nodiscard]] bool empty() const { return entry_ == nullptr; }
+  operator StringView() const { return {data(), length()}; }
+  bool operator==(InternedString other) const {
+    return entry_ == other.entry_;
+  }
+  bool operator!=(InternedString other) const {
+    return entry_ != other.entry_;
+  }
+  [[nodiscard]] uintptr_t id() const {
+    return reinterpret_cast<uintptr_t>(entry_);
+  }
+
+ private:
+  friend class StringPool;
+  struct Entry {
+    uint64_t hash;
+    size_t length;
+
+    const char* data() const { return reinterpret_cast<const char*>(this + 1); }
+  };
+
+  explicit InternedString(const Entry* entry) : entry_(entry) {}
+
+  const Entry* entry_ = nullptr;
+};
+
+template <>
+struct std::hash<InternedString> {
+  size_t operator()(InternedString string) const {
+    uint64_t id = string.id();
+    id = (id ^ (id >> 33)) * 0xFF51AFD7ED558CCDULL;
+    return static_cast<size_t>(id ^ (id >> 33));
+  }
+};
+
+class StringPool {
+ public:
+  struct Statistics {
+    size_t unique_strings;
+    size_t unique_bytes;
+    size_t intern_calls;
+    size_t hits;
+    size_t saved_bytes;
+  };
+
+  StringPool();
+  StringPool(const StringPool&) = delete;
+  StringPool& operator=(const StringPool&) = delete;
+  ~StringPool();
+  InternedString intern(StringView text);
+  [[nodiscard]] Statistics statistics() const;
+
+ private:
+  using Entry = InternedString::Entry;
+
+  static constexpr size_t kShardCount = 16;
+  static constexpr size_t kShardBits = 4;
+  static constexpr size_t kInitialSlots = 64;
+
+  struct Table {
+    size_t mask;
+    std::unique_ptr<std::atomic<const Entry*>[]> slots;
+
+    explicit Table(size_t slot_count);
+  };
+
+  struct alignas(64) Shard {
+    std::atomic<const Table*> table;
+    std::mutex mutex;
+    // Grown-out tables stay alive for readers that still probe them.
+    std::vector<std::unique_ptr<Table>> tables;
+    size_t count = 0;
+  };
+
+  Shard shards_[kShardCount];
+  std::atomic<size_t> unique_strings_ = 0;
+  std::atomic<size_t> unique_bytes_ = 0;
+  std::atomic<size_t> intern_calls_ = 0;
+  std::atomic<size_t> hits_ = 0;
+  std::atomic<size_t> saved_bytes_ = 0;
+
+  static const Entry* Find(const Table& table, StringView text, uint64_t hash);
+  static void Place(const Table& table, const Entry* entry);
+  static const Entry* MakeEntry(StringView text, uint64_t hash);
+  const Entry* insert(Shard& shard, StringView text, uint64_t hash);
+  void grow(Shard& shard);
+};
@@ -0,0 +1,281 @@
+#include "string_search.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) and defined(__x86_64__)
+#include <immintrin.h>
+#define STRING_SEARCH_X86
+#endif
+
+namespace {
+
+const size_t kMaxShortNeedle = 64;
+
+template <bool Space>
+size_t FindSpaceScalar(const char* haystack, size_t haystack_length,
+                       size_t start) {
+  for (size_t i = start; i < haystack_length; ++i) {
+    if (IsSpace(haystack[i]) == Space) {
+      return i;
+    }
+  }
+  return haystack_length;
+}
+
+#ifdef STRING_SEARCH_X86
+template <bool Space>
+size_t FindSpaceSse2(const char* haystack, size_t haystack_length) {
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i control_range = _mm_set1_epi8('\r' - '\t');
+  size_t i = 0;
+  for (; i + 16 <= haystack_length; i += 16) {
+    __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+    __m128i shifted = _mm_sub_epi8(block, tab);
+    __m128i is_space = _mm_or_si128(
+        _mm_cmpeq_epi8(block, space),
+        _mm_cmpeq_epi8(_mm_min_epu8(shifted, control_range), shifted));
+    auto mask = static_cast<unsigned>(_mm_movemask_epi8(is_space));
+    if (!Space) {
+      mask ^= 0xFFFF;
+    }
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+  return FindSpaceScalar<Space>(haystack, haystack_length, i);
+}
+#endif
+
+size_t FindShortScalar(const char* haystack, size_t haystack_length,
+                       const char* needle, size_t needle_length, size_t start) {
+  const char* last_start = haystack + haystack_length - needle_length;
+  const char* current = haystack + start;
+  while (current <= last_start) {
+    const void* candidate =
+        std::memchr(current, needle[0], last_start - current + 1);
+    if (candidate == nullptr) {
+      break;
+    }
+    current = static_cast<const char*>(candidate);
+    if (current[needle_length - 1] == needle[needle_length - 1] and
+        std::memcmp(current + 1, needle + 1, needle_length - 2) == 0) {
+      return current - haystack;
+    }
+    ++current;
+  }
+  return haystack_length;
+}
+
+#ifdef STRING_SEARCH_X86
+size_t FindShortSse2(const char* haystack, size_t haystack_length,
+                     const char* needle, size_t needle_length) {
+  const __m128i first = _mm_set1_epi8(needle[0]);
+  const __m128i last = _mm_set1_epi8(needle[needle_length - 1]);
+  size_t i = 0;
+  for (; i + needle_length - 1 + 16 <= haystack_length; i += 16) {
+    __m128i block_first = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(haystack + i));
+    __m128i block_last = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(haystack + i + needle_length - 1));
+    auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+        _mm_and_si128(_mm_cmpeq_epi8(first, block_first),
+                      _mm_cmpeq_epi8(last, block_last))));
+    while (mask != 0) {
+      size_t position = i + __builtin_ctz(mask);
+      if (std::memcmp(haystack + position + 1, needle + 1,
+                      needle_length - 2) == 0) {
+        return position;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return FindShortScalar(haystack, haystack_length, needle, needle_length, i);
+}
+
+__attribute__((target("avx2"))) size_t FindShortAvx2(
+    const char* haystack, size_t haystack_length, const char* needle,
+    size_t needle_length) {
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[needle_length - 1]);
+  size_t i = 0;
+  for (; i + needle_length - 1 + 32 <= haystack_length; i += 32) {
+    __m256i block_first = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(haystack + i));
+    __m256i block_last = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(haystack + i + needle_length - 1));
+    auto mask = static_cast<unsigned>(_mm256_movemask_epi8(
+        _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first),
+                         _mm256_cmpeq_epi8(last, block_last))));
+    while (mask != 0) {
+      size_t position = i + __builtin_ctz(mask);
+      if (std::memcmp(haystack + position + 1, needle + 1,
+                      needle_length - 2) == 0) {
+        return position;
+      }
+      mask &= mask - 1;
+    }
+  }
+  return FindShortScalar(haystack, haystack_length, needle, needle_length, i);
+}
+#endif
+
+size_t FindShort(const char* haystack, size_t haystack_length,
+                 const char* needle, size_t needle_length) {
+#ifdef STRING_SEARCH_X86
+  static const bool kHasAvx2 = __builtin_cpu_supports("avx2");
+  if (kHasAvx2) {
+    return FindShortAvx2(haystack, haystack_length, needle, needle_length);
+  }
+  return FindShortSse2(haystack, haystack_length, needle, needle_length);
+#else
+  return FindShortScalar(haystack, haystack_length, needle, needle_length, 0);
+#endif
+}
+
+size_t FindHorspool(const char* haystack, size_t haystack_length,
+                    const char* needle, size_t needle_length) {
+  size_t shift[256];
+  std::fill(shift, shift + 256, needle_length);
+  for (size_t i = 0; i + 1 < needle_length; ++i) {
+    shift[static_cast<unsigned char>(needle[i])] = needle_length - 1 - i;
+  }
+  const char last = needle[needle_length - 1];
+  size_t position = 0;
+  while (position + needle_length <= haystack_length) {
+    char symbol = haystack[position + needle_length - 1];
+    if (symbol == last and
+        std::memcmp(haystack + position, needle, needle_length - 1) == 0) {
+      return position;
+    }
+    position += shift[static_cast<unsigned char>(symbol)];
+  }
+  return haystack_length;
+}
+
+size_t RFindHorspool(const char* haystack, size_t haystack_length,
+                     const char* needle, size_t needle_length) {
+  size_t shift[256];
+  std::fill(shift, shift + 256, needle_length);
+  for (size_t i = needle_length - 1; i > 0; --i) {
+    shift[static_cast<unsigned char>(needle[i])] = i;
+  }
+  const char first = needle[0];
+  size_t position = haystack_length - needle_length;
+  while (true) {
+    char symbol = haystack[position];
+    if (symbol == first and std::memcmp(haystack + position + 1, needle + 1,
+                                        needle_length - 1) == 0) {
+      return position;
+    }
+    size_t step = shift[static_cast<unsigned char>(symbol)];
+    if (position < step) {
+      return haystack_length;
+    }
+    position -= step;
+  }
+}
+
+}  // namespace
+
+ByteSet::ByteSet(const char* symbols, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    insert(symbols[i]);
+  }
+}
+
+size_t FindChar(const char* haystack, size_t haystack_length, char symbol) {
+  const void* found = std::memchr(haystack, symbol, haystack_length);
+  if (found == nullptr) {
+    return haystack_length;
+  }
+  return static_cast<const char*>(found) - haystack;
+}
+
+size_t RFindChar(const char* haystack, size_t haystack_length, char symbol) {
+  for (size_t i = haystack_length; i > 0; --i) {
+    if (haystack[i - 1] == symbol) {
+      return i - 1;
+    }
+  }
+  return haystack_length;
+}
+
+size_t FindFirstOf(const char* haystack, size_t haystack_length,
+                   const ByteSet& symbols) {
+  for (size_t i = 0; i < haystack_length; ++i) {
+    if (symbols.contains(haystack[i])) {
+      return i;
+    }
+  }
+  return haystack_length;
+}
+
+size_t FindMismatch(const char* first, const char* second, size_t length) {
+  size_t i = 0;
+#ifdef STRING_SEARCH_X86
+  for (; i + 16 <= length; i += 16) {
+    __m128i block1 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+    __m128i block2 =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+    auto mask = static_cast<unsigned>(
+        _mm_movemask_epi8(_mm_cmpeq_epi8(block1, block2)) ^ 0xFFFF);
+    if (mask != 0) {
+      return i + __builtin_ctz(mask);
+    }
+  }
+#endif
+  while (i < length and first[i] == second[i]) {
+    ++i;
+  }
+  return i;
+}
+
+size_t FindSpace(const char* haystack, size_t haystack_length) {
+#ifdef STRING_SEARCH_X86
+  return FindSpaceSse2<true>(haystack, haystack_length);
+#else
+  return FindSpaceScalar<true>(haystack, haystack_length, 0);
+#endif
+}
+
+size_t FindNotSpace(const char* haystack, size_t haystack_length) {
+#ifdef STRING_SEARCH_X86
+  return FindSpaceSse2<false>(haystack, haystack_length);
+#else
+  return FindSpaceScalar<false>(haystack, haystack_length, 0);
+#endif
+}
+
+size_t FindSubstring(const char* haystack, size_t haystack_length,
+                     const char* needle, size_t needle_length) {
+  if (needle_length == 0) {
+    return 0;
+  }
+  if (needle_length > haystack_length) {
+    return haystack_length;
+  }
+  if (needle_length == 1) {
+    return FindChar(haystack, haystack_length, needle[0]);
+  }
+  if (needle_length <= kMaxShortNeedle) {
+    return FindShort(haystack, haystack_length, needle, needle_length);
+  }
+  return FindHorspool(haystack, haystack_length, needle, needle_length);
+}
+
+size_t RFindSubstring(const char* haystack, size_t haystack_length,
+                      const char* needle, size_t needle_length) {
+  if (needle_length == 0) {
+    return haystack_length;
+  }
+  if (needle_length > haystack_length) {
+    return haystack_length;
+  }
+  if (needle_length == 1) {
+    return RFindChar(haystack, haystack_length, needle[0]);
+  }
+  return RFindHorspool(haystack, haystack_length, needle, needle_length);
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+inline bool IsSpace(char symbol) {
+  return symbol == ' ' or
+         static_cast<unsigned char>(symbol - '\t') <= '\r' - '\t';
+}
+
+class ByteSet {
+ public:
+  ByteSet() = default;
+  ByteSet(const char* symbols, size_t count);
+  void insert(char symbol) {
+    auto byte = static_cast<unsigned char>(symbol);
+    words_[byte / 64] |= uint64_t(1) << (byte % 64);
+  }
+  bool contains(char symbol) const {
+    auto byte = static_cast<unsigned char>(symbol);
+    return ((words_[byte / 64] >> (byte % 64)) & 1) != 0;
+  }
+
+ private:
+  uint64_t words_[4] = {};
+};
+
+// All functions return the searched length when nothing is found.
+size_t FindChar(const char* haystack, size_t haystack_length, char symbol);
+size_t RFindChar(const char* haystack, size_t haystack_length, char symbol);
+size_t FindFirstOf(const char* haystack, size_t haystack_length,
+                   const ByteSet& symbols);
+size_t FindMismatch(const char* first, const char* second, size_t length);
+size_t FindSpace(const char* haystack, size_t haystack_length);
+size_t FindNotSpace(const char* haystack, size_t haystack_length);
+size_t FindSubstring(const char* haystack, size_t haystack_length,
+                     const char* needle, size_t needle_length);
+size_t RFindSubstring(const char* haystack, size_t haystack_length,
+                      const char* needle, size_t needle_length);
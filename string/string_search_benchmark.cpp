@@ -0,0 +1,108 @@
+// Scan throughput of String::find, rfind and find_first_of against the
+// std::string equivalents across needle and haystack sizes. The needle sits
+// only at the far end of the haystack, so every search covers all of it.
+// Not part of any build; run it with
+//   g++ -std=c++20 -O2 string/string_search_benchmark.cpp
+//       $(ls string/*.cpp | grep -v _benchmark) -o search_bench
+//   ./search_bench
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include "string.h"
+
+namespace {
+
+const size_t kBytesPerTest = size_t(1) << 28;
+
+size_t sink = 0;
+
+// Lower-case words and spaces, like a log line without its digits; 'z' is
+// left out so that needles can be kept out of the text.
+std::string Haystack(size_t length) {
+  std::minstd_rand random(42);
+  std::string text(length, ' ');
+  for (char& symbol : text) {
+    if (random() % 6 != 0) {
+      symbol = static_cast<char>('a' + random() % 25);
+    }
+  }
+  return text;
+}
+
+// Common letters with a 'z' in the middle: the first and last bytes are as
+// frequent as in the text, yet the needle only occurs where it is placed.
+std::string Needle(size_t length) {
+  std::minstd_rand random(7);
+  std::string needle(length, ' ');
+  for (char& symbol : needle) {
+    symbol = static_cast<char>('a' + random() % 25);
+  }
+  needle[length / 2] = 'z';
+  return needle;
+}
+
+template <typename Search>
+double GigabytesPerSecond(size_t haystack_length, Search search) {
+  size_t repeats = kBytesPerTest / haystack_length;
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < repeats; ++i) {
+    sink += search();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return double(repeats * haystack_length) / elapsed.count() / 1e9;
+}
+
+void CompareFind(size_t haystack_length, size_t needle_length) {
+  std::string needle = Needle(needle_length);
+  std::string text = Haystack(haystack_length);
+  std::string reversed = text;
+  text.replace(text.size() - needle_length, needle_length, needle);
+  reversed.replace(0, needle_length, needle);
+  String string_text(StringView(text.data(), text.size()));
+  String string_reversed(StringView(reversed.data(), reversed.size()));
+  String string_needle(StringView(needle.data(), needle.size()));
+  double find = GigabytesPerSecond(
+      haystack_length, [&] { return string_text.find(string_needle); });
+  double std_find = GigabytesPerSecond(
+      haystack_length, [&] { return text.find(needle); });
+  double rfind = GigabytesPerSecond(
+      haystack_length, [&] { return string_reversed.rfind(string_needle); });
+  double std_rfind = GigabytesPerSecond(
+      haystack_length, [&] { return reversed.rfind(needle); });
+  std::printf("%9zu %7zu %10.2f %10.2f %10.2f %10.2f\n", haystack_length,
+              needle_length, find, std_find, rfind, std_rfind);
+}
+
+void CompareFindFirstOf(size_t haystack_length) {
+  std::string text = Haystack(haystack_length);
+  text.back() = '\n';
+  String string_text(StringView(text.data(), text.size()));
+  double find = GigabytesPerSecond(haystack_length, [&] {
+    return string_text.find_first_of("\n\r;\"");
+  });
+  double std_find = GigabytesPerSecond(
+      haystack_length, [&] { return text.find_first_of("\n\r;\""); });
+  std::printf("%9zu %10.2f %10.2f\n", haystack_length, find, std_find);
+}
+
+}  // namespace
+
+int main() {
+  const size_t kHaystacks[] = {size_t(1) << 12, size_t(1) << 20,
+                               size_t(1) << 24};
+  std::printf("GB/s    haystack  needle       find   std find      rfind"
+              "  std rfind\n");
+  for (size_t haystack_length : kHaystacks) {
+    for (size_t needle_length : {1, 4, 16, 64, 256}) {
+      CompareFind(haystack_length, needle_length);
+    }
+  }
+  std::printf("GB/s    haystack  find_first_of  std\n");
+  for (size_t haystack_length : kHaystacks) {
+    CompareFindFirstOf(haystack_length);
+  }
+  std::printf("checksum %zu\n", sink);
+}
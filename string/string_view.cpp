@@ -0,0 +1,127 @@
+#include "string_view.h"
+#include <algorithm>
+
+void StringView::remove_prefix(size_t count) {
+  data_ += count;
+  length_ -= count;
+}
+
+size_t StringView::find(StringView substring) const {
+  return FindSubstring(data_, length_, substring.data_, substring.length_);
+}
+
+size_t StringView::find(char symbol) const {
+  return FindChar(data_, length_, symbol);
+}
+
+size_t StringView::rfind(StringView substring) const {
+  return RFindSubstring(data_, length_, substring.data_, substring.length_);
+}
+
+size_t StringView::rfind(char symbol) const {
+  return RFindChar(data_, length_, symbol);
+}
+
+size_t StringView::find_first_of(StringView symbols) const {
+  return FindFirstOf(data_, length_, ByteSet(symbols.data_, symbols.length_));
+}
+
+StringView StringView::substr(size_t start, size_t count) const {
+  return {data_ + start, std::min(count, length_ - start)};
+}
+
+bool operator==(StringView view1, StringView view2) {
+  return view1.length() == view2.length() and
+         FindMismatch(view1.data(), view2.data(), view1.length()) ==
+             view1.length();
+}
+
+bool operator!=(StringView view1, StringView view2) {
+  return !(view1 == view2);
+}
+
+bool operator<(StringView view1, StringView view2) {
+  size_t common = std::min(view1.length(), view2.length());
+  size_t mismatch = FindMismatch(view1.data(), view2.data(), common);
+  if (mismatch == common) {
+    return view1.length() < view2.length();
+  }
+  return static_cast<unsigned char>(view1[mismatch]) <
+         static_cast<unsigned char>(view2[mismatch]);
+}
+
+bool operator>(StringView view1, StringView view2) { return view2 < view1; }
+
+bool operator<=(StringView view1, StringView view2) {
+  return !(view1 > view2);
+}
+
+bool operator>=(StringView view1, StringView view2) {
+  return !(view1 < view2);
+}
+
+std::ostream& operator<<(std::ostream& out, StringView view) {
+  return out.write(view.data(), static_cast<std::streamsize>(view.length()));
+}
+
+SplitRange::SplitRange(StringView text, StringView delimiters,
+                       bool skip_empty)
+    : text_(text),
+      delimiters_(delimiters.data(), delimiters.length()),
+      delimiter_(delimiters.empty() ? '\0' : delimiters[0]),
+      single_delimiter_(delimiters.length() == 1),
+      skip_empty_(skip_empty) {}
+
+SplitRange::Iterator SplitRange::begin() const { return {this, 0}; }
+
+SplitRange::Iterator SplitRange::end() const {
+  return {this, text_.length() + 1};
+}
+
+size_t SplitRange::find_delimiter(size_t start) const {
+  const char* from = text_.data() + start;
+  size_t rest = text_.length() - start;
+  if (single_delimiter_) {
+    return start + FindChar(from, rest, delimiter_);
+  }
+  return start + FindFirstOf(from, rest, delimiters_);
+}
+
+SplitRange::Iterator::Iterator(const SplitRange* range, size_t start)
+    : range_(range), start_(start) {
+  find_token();
+}
+
+SplitRange::Iterator& SplitRange::Iterator::operator++() {
+  start_ += token_.length() + 1;
+  find_token();
+  return *this;
+}
+
+SplitRange::Iterator SplitRange::Iterator::operator++(int) {
+  Iterator copy = *this;
+  ++*this;
+  return copy;
+}
+
+void SplitRange::Iterator::find_token() {
+  const StringView& text = range_->text_;
+  while (start_ <= text.length()) {
+    size_t finish = range_->find_delimiter(start_);
+    if (finish != start_ or !range_->skip_empty_) {
+      token_ = text.substr(start_, finish - start_);
+      return;
+    }
+    ++start_;
+  }
+  start_ = text.length() + 1;
+  token_ = StringView();
+}
+
+SplitRange Split(StringView text, char delimiter) {
+  return {text, StringView(&delimiter, 1), false};
+}
+
+SplitRange Tokenize(StringView text, StringView delimiters) {
+  return {text, delimiters, true};
+}
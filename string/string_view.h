@@ -0,0 +1,98 @@
+#pragma once
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include "string_hash.h"
+#include "string_search.h"
+
+class StringView {
+ public:
+  StringView() : data_(""), length_(0) {}
+  StringView(const char* c_string)
+      : data_(c_string), length_(std::strlen(c_string)) {}
+  StringView(const char* data, size_t length) : data_(data), length_(length) {}
+  const char& operator[](size_t ind) const { return data_[ind]; }
+  [[nodiscard]] size_t length() const { return length_; }
+  [[nodiscard]] size_t size() const { return length_; }
+  [[nodiscard]] bool empty() const { return length_ == 0; }
+  [[nodiscard]] const char* data() const { return data_; }
+  const char* begin() const { return data_; }
+  const char* end() const { return data_ + length_; }
+  const char& front() const { return data_[0]; }
+  const char& back() const { return data_[length_ - 1]; }
+  void remove_prefix(size_t count);
+  void remove_suffix(size_t count) { length_ -= count; }
+  size_t find(StringView substring) const;
+  size_t find(char symbol) const;
+  size_t rfind(StringView substring) const;
+  size_t rfind(char symbol) const;
+  size_t find_first_of(StringView symbols) const;
+  StringView substr(size_t start, size_t count) const;
+
+ private:
+  const char* data_;
+  size_t length_;
+};
+
+bool operator==(StringView view1, StringView view2);
+bool operator!=(StringView view1, StringView view2);
+bool operator<(StringView view1, StringView view2);
+bool operator>(StringView view1, StringView view2);
+bool operator<=(StringView view1, StringView view2);
+bool operator>=(StringView view1, StringView view2);
+std::ostream& operator<<(std::ostream& out, StringView view);
+
+template <>
+struct std::hash<StringView> {
+  size_t operator()(StringView view) const {
+    return static_cast<size_t>(HashBytes(view.data(), view.length()));
+  }
+};
+
+class SplitRange {
+ public:
+  class Iterator;
+
+  SplitRange(StringView text, StringView delimiters, bool skip_empty);
+  Iterator begin() const;
+  Iterator end() const;
+
+ private:
+  StringView text_;
+  ByteSet delimiters_;
+  char delimiter_;
+  bool single_delimiter_;
+  bool skip_empty_;
+
+  size_t find_delimiter(size_t start) const;
+};
+
+class SplitRange::Iterator {
+ public:
+  using value_type = StringView;
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using reference = const StringView&;
+  using pointer = const StringView*;
+
+  Iterator() = default;
+  Iterator(const SplitRange* range, size_t start);
+  reference operator*() const { return token_; }
+  pointer operator->() const { return &token_; }
+  Iterator& operator++();
+  Iterator operator++(int);
+  bool operator==(const Iterator& other) const {
+    return range_ == other.range_ and start_ == other.start_;
+  }
+
+ private:
+  const SplitRange* range_ = nullptr;
+  size_t start_ = 0;
+  StringView token_;
+
+  void find_token();
+};
+
+SplitRange Split(StringView text, char delimiter);
+SplitRange Tokenize(StringView text, StringView delimiters = " \t\n\v\f\r");
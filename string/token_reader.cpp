@@ -0,0 +1,55 @@
+#include "token_reader.h"
+
+TokenReader::TokenReader(std::istream& flow_in, size_t buffer_size)
+    : flow_in_(flow_in), buffer_(buffer_size), begin_(0), end_(0) {}
+
+bool TokenReader::read_token(String& token) {
+  token.clear();
+  while (true) {
+    if (available() == 0 and !fill()) {
+      return false;
+    }
+    begin_ += FindNotSpace(current(), available());
+    if (available() != 0) {
+      break;
+    }
+  }
+  while (true) {
+    size_t run = FindSpace(current(), available());
+    token += StringView(current(), run);
+    begin_ += run;
+    if (available() != 0 or !fill()) {
+      return true;
+    }
+  }
+}
+
+bool TokenReader::read_line(String& line, char delimiter) {
+  line.clear();
+  if (available() == 0 and !fill()) {
+    return false;
+  }
+  while (true) {
+    size_t run = FindChar(current(), available(), delimiter);
+    line += StringView(current(), run);
+    begin_ += run;
+    if (available() != 0) {
+      ++begin_;
+      return true;
+    }
+    if (!fill()) {
+      return true;
+    }
+  }
+}
+
+bool TokenReader::fill() {
+  begin_ = 0;
+  end_ = static_cast<size_t>(flow_in_.rdbuf()->sgetn(
+      buffer_.data(), static_cast<std::streamsize>(buffer_.size())));
+  if (end_ == 0) {
+    flow_in_.setstate(std::ios_base::eofbit);
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include "string.h"
+
+// Reads the stream in large chunks, so the stream must not be read
+// directly while a TokenReader is attached to it.
+class TokenReader {
+ public:
+  static const size_t kDefaultBufferSize = 1 << 16;
+
+  explicit TokenReader(std::istream& flow_in,
+                       size_t buffer_size = kDefaultBufferSize);
+  bool read_token(String& token);
+  bool read_line(String& line, char delimiter = '\n');
+
+ private:
+  std::istream& flow_in_;
+  std::vector<char> buffer_;
+  size_t begin_;
+  size_t end_;
+
+  bool fill();
+  const char* current() const { return buffer_.data() + begin_; }
+  size_t available() const { return end_ - begin_; }
+};
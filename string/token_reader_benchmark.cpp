@@ -0,0 +1,148 @@
+// Reading a whitespace-separated token file and writing it back: String's
+// operator>>, getline and TokenReader against std::string on the same
+// streams. Not part of any build; run it with
+//   g++ -std=c++20 -O2 string/token_reader_benchmark.cpp
+//       $(ls string/*.cpp | grep -v _benchmark) -o token_bench
+//   ./token_bench [scratch file, /tmp/token_benchmark.txt by default]
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include "token_reader.h"
+
+namespace {
+
+const size_t kFileSize = size_t(64) << 20;
+
+void WriteTokens(const char* path) {
+  std::ofstream out(path, std::ios::binary);
+  std::minstd_rand random(3);
+  std::string line;
+  for (size_t written = 0; written < kFileSize; written += line.size()) {
+    line.clear();
+    for (int token = 0; token < 12; ++token) {
+      size_t length = 1 + random() % 14;
+      for (size_t i = 0; i < length; ++i) {
+        line += static_cast<char>('a' + random() % 26);
+      }
+      line += token == 11 ? '\n' : ' ';
+    }
+    out << line;
+  }
+}
+
+struct Count {
+  size_t items = 0;
+  size_t bytes = 0;
+  bool operator==(const Count&) const = default;
+};
+
+template <typename Read>
+Count Time(const char* name, const char* path, Read read) {
+  std::ifstream flow_in(path, std::ios::binary);
+  auto start = std::chrono::steady_clock::now();
+  Count count = read(flow_in);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  std::printf("%-30s %8.1f ms %8.1f MB/s\n", name, elapsed.count() * 1e3,
+              kFileSize / elapsed.count() / 1e6);
+  return count;
+}
+
+void Expect(bool condition, const char* what) {
+  if (!condition) {
+    std::fprintf(stderr, "FAILED: %s\n", what);
+    std::exit(1);
+  }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  const char* path = argc > 1 ? argv[1] : "/tmp/token_benchmark.txt";
+  WriteTokens(path);
+
+  Count std_tokens = Time("std::string >>", path, [](std::istream& in) {
+    Count count;
+    for (std::string token; in >> token; ++count.items) {
+      count.bytes += token.size();
+    }
+    return count;
+  });
+  Count string_tokens = Time("String >>", path, [](std::istream& in) {
+    Count count;
+    for (String token; in >> token; ++count.items) {
+      count.bytes += token.size();
+    }
+    return count;
+  });
+  Count reader_tokens = Time("TokenReader::read_token", path,
+                             [](std::istream& in) {
+    Count count;
+    TokenReader reader(in);
+    for (String token; reader.read_token(token); ++count.items) {
+      count.bytes += token.size();
+    }
+    return count;
+  });
+  Expect(std_tokens == string_tokens and std_tokens == reader_tokens,
+         "all token readers see the same tokens");
+
+  Count std_lines = Time("std::getline", path, [](std::istream& in) {
+    Count count;
+    for (std::string line; std::getline(in, line); ++count.items) {
+      count.bytes += line.size();
+    }
+    return count;
+  });
+  Count string_lines = Time("getline(String)", path, [](std::istream& in) {
+    Count count;
+    for (String line; getline(in, line); ++count.items) {
+      count.bytes += line.size();
+    }
+    return count;
+  });
+  Count reader_lines = Time("TokenReader::read_line", path,
+                            [](std::istream& in) {
+    Count count;
+    TokenReader reader(in);
+    for (String line; reader.read_line(line); ++count.items) {
+      count.bytes += line.size();
+    }
+    return count;
+  });
+  Expect(std_lines == string_lines and std_lines == reader_lines,
+         "all line readers see the same lines");
+
+  std::vector<std::string> std_strings;
+  std::vector<String> strings;
+  {
+    std::ifstream flow_in(path, std::ios::binary);
+    for (std::string line; std::getline(flow_in, line);) {
+      strings.emplace_back(StringView(line.data(), line.size()));
+      std_strings.push_back(std::move(line));
+    }
+  }
+  for (int pass = 0; pass < 2; ++pass) {
+    std::ofstream out("/dev/null", std::ios::binary);
+    auto start = std::chrono::steady_clock::now();
+    if (pass == 0) {
+      for (const std::string& line : std_strings) {
+        out << line << '\n';
+      }
+    } else {
+      for (const String& line : strings) {
+        out << line << '\n';
+      }
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    std::printf("%-30s %8.1f ms %8.1f MB/s\n",
+                pass == 0 ? "std::string <<" : "String <<",
+                elapsed.count() * 1e3, kFileSize / elapsed.count() / 1e6);
+  }
+  std::remove(path);
+}
@@ -0,0 +1,316 @@
+#include "utf8.h"
+
+#if defined(__GNUC__) and defined(__x86_64__)
+#include <immintrin.h>
+#define UTF8_X86
+#endif
+
+namespace {
+
+const char32_t kInvalid = 0xFFFFFFFF;
+
+bool IsContinuation(char symbol) {
+  return (static_cast<unsigned char>(symbol) & 0xC0) == 0x80;
+}
+
+bool IsValidScalar(const char* data, size_t length) {
+  size_t i = 0;
+  while (i < length) {
+    if (static_cast<unsigned char>(data[i]) < 0x80) {
+      ++i;
+      continue;
+    }
+    size_t consumed = 0;
+    DecodeCodePoint(data + i, length - i, consumed);
+    if (consumed == 0) {
+      return false;
+    }
+    i += consumed;
+  }
+  return true;
+}
+
+template <char First, char Last>
+void ShiftCaseScalar(char* data, size_t length) {
+  for (size_t i = 0; i < length; ++i) {
+    if (static_cast<unsigned char>(data[i] - First) <= Last - First) {
+      data[i] ^= 0x20;
+    }
+  }
+}
+
+#ifdef UTF8_X86
+// Lookup-table validation from Keiser and Lemire, "Validating UTF-8 In Less
+// Than One Instruction Per Byte": each byte is classified together with its
+// predecessor through three 16-entry tables, and any surviving bit is an error.
+const uint8_t kTooShort = 1 << 0;
+const uint8_t kTooLong = 1 << 1;
+const uint8_t kOverlong3 = 1 << 2;
+const uint8_t kTooLarge = 1 << 3;
+const uint8_t kSurrogate = 1 << 4;
+const uint8_t kOverlong2 = 1 << 5;
+const uint8_t kTooLarge1000 = 1 << 6;
+const uint8_t kOverlong4 = 1 << 6;
+const uint8_t kTwoConts = 1 << 7;
+const uint8_t kCarry = kTooShort | kTooLong | kTwoConts;
+
+__attribute__((target("ssse3"))) __m128i Lookup(__m128i table,
+                                                __m128i nibbles) {
+  return _mm_shuffle_epi8(table, nibbles);
+}
+
+__attribute__((target("ssse3"))) __m128i CheckSpecialCases(__m128i input,
+                                                           __m128i prev1) {
+  const __m128i low_nibble = _mm_set1_epi8(0x0F);
+  const __m128i byte1_high_table = _mm_setr_epi8(
+      kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong, kTooLong,
+      kTooLong, kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+      kTooShort | kOverlong2, kTooShort, kTooShort | kOverlong3 | kSurrogate,
+      static_cast<char>(kTooShort | kTooLarge | kTooLarge1000 | kOverlong4));
+  const __m128i byte1_low_table = _mm_setr_epi8(
+      static_cast<char>(kCarry | kOverlong3 | kOverlong2 | kOverlong4),
+      static_cast<char>(kCarry | kOverlong2), static_cast<char>(kCarry),
+      static_cast<char>(kCarry), static_cast<char>(kCarry | kTooLarge),
+      static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+      static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+      static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+      static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+      static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+      static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+      static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+      static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+      static_cast<char>(kCarry | kTooLarge | kTooLarge1000 | kSurrogate),
+      static_cast<char>(kCarry | kTooLarge | kTooLarge1000),
+      static_cast<char>(kCarry | kTooLarge | kTooLarge1000));
+  const __m128i byte2_high_table = _mm_setr_epi8(
+      kTooShort, kTooShort, kTooShort, kTooShort, kTooShort, kTooShort,
+      kTooShort, kTooShort,
+      static_cast<char>(kTooLong | kOverlong2 | kTwoConts | kOverlong3 |
+                        kTooLarge1000 | kOverlong4),
+      static_cast<char>(kTooLong | kOverlong2 | kTwoConts | kOverlong3 |
+                        kTooLarge),
+      static_cast<char>(kTooLong | kOverlong2 | kTwoConts | kSurrogate |
+                        kTooLarge),
+      static_cast<char>(kTooLong | kOverlong2 | kTwoConts | kSurrogate |
+                        kTooLarge),
+      kTooShort, kTooShort, kTooShort, kTooShort);
+  __m128i byte1_high = Lookup(
+      byte1_high_table, _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble));
+  __m128i byte1_low =
+      Lookup(byte1_low_table, _mm_and_si128(prev1, low_nibble));
+  __m128i byte2_high = Lookup(
+      byte2_high_table, _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble));
+  return _mm_and_si128(_mm_and_si128(byte1_high, byte1_low), byte2_high);
+}
+
+__attribute__((target("ssse3"))) size_t ValidateSsse3(const char* data,
+                                                      size_t length,
+                                                      bool& valid) {
+  __m128i previous = _mm_setzero_si128();
+  __m128i error = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i input =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    if (_mm_movemask_epi8(input) == 0 and
+        (_mm_movemask_epi8(previous) & 0xE000) == 0) {
+      previous = input;
+      continue;
+    }
+    __m128i prev1 = _mm_alignr_epi8(input, previous, 15);
+    __m128i prev2 = _mm_alignr_epi8(input, previous, 14);
+    __m128i prev3 = _mm_alignr_epi8(input, previous, 13);
+    __m128i must_continue = _mm_or_si128(
+        _mm_subs_epu8(prev2, _mm_set1_epi8(static_cast<char>(0xE0 - 0x80))),
+        _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xF0 - 0x80))));
+    must_continue =
+        _mm_and_si128(must_continue, _mm_set1_epi8(static_cast<char>(0x80)));
+    error = _mm_or_si128(
+        error, _mm_xor_si128(must_continue, CheckSpecialCases(input, prev1)));
+    previous = input;
+  }
+  valid = _mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) ==
+          0xFFFF;
+  return i;
+}
+
+size_t CountContinuationsSse2(const char* data, size_t length, size_t& count) {
+  const __m128i threshold = _mm_set1_epi8(-64);
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    count += __builtin_popcount(
+        _mm_movemask_epi8(_mm_cmplt_epi8(block, threshold)));
+  }
+  return i;
+}
+
+template <char First, char Last>
+size_t ShiftCaseSse2(char* data, size_t length) {
+  const __m128i first = _mm_set1_epi8(First);
+  const __m128i range = _mm_set1_epi8(Last - First);
+  const __m128i flip = _mm_set1_epi8(0x20);
+  size_t i = 0;
+  for (; i + 16 <= length; i += 16) {
+    auto* address = reinterpret_cast<__m128i*>(data + i);
+    __m128i block = _mm_loadu_si128(address);
+    __m128i shifted = _mm_sub_epi8(block, first);
+    __m128i is_letter =
+        _mm_cmpeq_epi8(_mm_min_epu8(shifted, range), shifted);
+    _mm_storeu_si128(address,
+                     _mm_xor_si128(block, _mm_and_si128(is_letter, flip)));
+  }
+  return i;
+}
+#endif
+
+}  // namespace
+
+char32_t DecodeCodePoint(const char* data, size_t length, size_t& consumed) {
+  consumed = 0;
+  auto lead = static_cast<unsigned char>(data[0]);
+  if (lead < 0x80) {
+    consumed = 1;
+    return lead;
+  }
+  size_t width;
+  char32_t code_point;
+  char32_t minimum;
+  if ((lead & 0xE0) == 0xC0) {
+    width = 2;
+    code_point = lead & 0x1F;
+    minimum = 0x80;
+  } else if ((lead & 0xF0) == 0xE0) {
+    width = 3;
+    code_point = lead & 0x0F;
+    minimum = 0x800;
+  } else if ((lead & 0xF8) == 0xF0) {
+    width = 4;
+    code_point = lead & 0x07;
+    minimum = 0x10000;
+  } else {
+    return kInvalid;
+  }
+  if (width > length) {
+    return kInvalid;
+  }
+  for (size_t i = 1; i < width; ++i) {
+    if (!IsContinuation(data[i])) {
+      return kInvalid;
+    }
+    code_point = (code_point << 6) | (data[i] & 0x3F);
+  }
+  if (code_point < minimum or code_point > 0x10FFFF or
+      (code_point >= 0xD800 and code_point <= 0xDFFF)) {
+    return kInvalid;
+  }
+  consumed = width;
+  return code_point;
+}
+
+bool IsValidUtf8(const char* data, size_t length) {
+  size_t start = 0;
+#ifdef UTF8_X86
+  static const bool kHasSsse3 = __builtin_cpu_supports("ssse3");
+  if (kHasSsse3) {
+    bool valid = true;
+    size_t checked = ValidateSsse3(data, length, valid);
+    if (!valid) {
+      return false;
+    }
+    start = checked;
+    for (size_t back = 0;
+         back < 3 and start > 0 and IsContinuation(data[start - 1]); ++back) {
+      --start;
+    }
+    if (start > 0 and static_cast<unsigned char>(data[start - 1]) >= 0xC0) {
+      --start;
+    }
+  }
+#endif
+  return IsValidScalar(data + start, length - start);
+}
+
+size_t CountCodePoints(const char* data, size_t length) {
+  size_t continuations = 0;
+  size_t i = 0;
+#ifdef UTF8_X86
+  i = CountContinuationsSse2(data, length, continuations);
+#endif
+  for (; i < length; ++i) {
+    continuations += IsContinuation(data[i]) ? 1 : 0;
+  }
+  return length - continuations;
+}
+
+void ToLowerAscii(char* data, size_t length) {
+  size_t done = 0;
+#ifdef UTF8_X86
+  done = ShiftCaseSse2<'A', 'Z'>(data, length);
+#endif
+  ShiftCaseScalar<'A', 'Z'>(data + done, length - done);
+}
+
+void ToUpperAscii(char* data, size_t length) {
+  size_t done = 0;
+#ifdef UTF8_X86
+  done = ShiftCaseSse2<'a', 'z'>(data, length);
+#endif
+  ShiftCaseScalar<'a', 'z'>(data + done, length - done);
+}
+
+bool Utf8View::valid() const {
+  if (valid_ < 0) {
+    valid_ = IsValidUtf8(text_.data(), text_.length()) ? 1 : 0;
+  }
+  return valid_ == 1;
+}
+
+size_t Utf8View::length() const {
+  if (length_ == kUnknown) {
+    if (valid()) {
+      length_ = CountCodePoints(text_.data(), text_.length());
+    } else {
+      length_ = 0;
+      for (auto it = begin(); it != end(); ++it) {
+        ++length_;
+      }
+    }
+  }
+  return length_;
+}
+
+Utf8View::Iterator Utf8View::begin() const {
+  return {text_.begin(), text_.end()};
+}
+
+Utf8View::Iterator Utf8View::end() const { return {text_.end(), text_.end()}; }
+
+Utf8View::Iterator::Iterator(const char* current, const char* end)
+    : current_(current), end_(end) {
+  decode();
+}
+
+Utf8View::Iterator& Utf8View::Iterator::operator++() {
+  current_ += width_;
+  decode();
+  return *this;
+}
+
+Utf8View::Iterator Utf8View::Iterator::operator++(int) {
+  Iterator copy = *this;
+  ++*this;
+  return copy;
+}
+
+void Utf8View::Iterator::decode() {
+  if (current_ == end_) {
+    width_ = 0;
+    return;
+  }
+  code_point_ = DecodeCodePoint(current_, end_ - current_, width_);
+  if (width_ == 0) {
+    code_point_ = kReplacementCharacter;
+    width_ = 1;
+  }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include "string_view.h"
+
+const char32_t kReplacementCharacter = 0xFFFD;
+
+bool IsValidUtf8(const char* data, size_t length);
+size_t CountCodePoints(const char* data, size_t length);
+char32_t DecodeCodePoint(const char* data, size_t length, size_t& consumed);
+void ToLowerAscii(char* data, size_t length);
+void ToUpperAscii(char* data, size_t length);
+
+class Utf8View {
+ public:
+  class Iterator;
+
+  explicit Utf8View(StringView text) : text_(text) {}
+  [[nodiscard]] bool valid() const;
+  [[nodiscard]] size_t length() const;
+  [[nodiscard]] StringView bytes() const { return text_; }
+  Iterator begin() const;
+  Iterator end() const;
+
+ private:
+  static constexpr size_t kUnknown = SIZE_MAX;
+
+  StringView text_;
+  mutable size_t length_ = kUnknown;
+  mutable int valid_ = -1;
+};
+
+class Utf8View::Iterator {
+ public:
+  using value_type = char32_t;
+  using iterator_category = std::forward_iterator_tag;
+  using difference_type = std::ptrdiff_t;
+  using reference = char32_t;
+  using pointer = const char32_t*;
+
+  Iterator() = default;
+  Iterator(const char* current, const char* end);
+  char32_t operator*() const { return code_point_; }
+  Iterator& operator++();
+  Iterator operator++(int);
+  bool operator==(const Iterator& other) const {
+    return current_ == other.current_;
+  }
+  [[nodiscard]] const char* position() const { return current_; }
+
+ private:
+  const char* current_ = nullptr;
+  const char* end_ = nullptr;
+  size_t width_ = 0;
+  char32_t code_point_ = 0;
+
+  void decode();
+};
@@ -0,0 +1,154 @@
+// UTF-8 validation, code point counting and iteration, and ASCII case
+// mapping on 4 MB corpora of different scripts, against byte-at-a-time
+// reference loops. Not part of any build; run it with
+//   g++ -std=c++20 -O2 string/utf8_benchmark.cpp
+//       $(ls string/*.cpp | grep -v _benchmark) -o utf8_bench && ./utf8_bench
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include "string.h"
+
+namespace {
+
+const size_t kCorpusSize = size_t(4) << 20;
+const int kRepeats = 20;
+
+struct Sample {
+  const char* name;
+  const char* text;
+};
+
+const Sample kSamples[] = {
+    {"ascii", "The quick brown fox jumps over the lazy dog; 42 times. "},
+    {"latin", "Voilà, Müller aß Crème brûlée in São Paulo, señor Øster. "},
+    {"cyrillic", "Съешь же ещё этих мягких французских булок, да выпей чаю. "},
+    {"cjk", "我能吞下玻璃而不伤身体。いろはにほへと、ちりぬるを。 "},
+    {"mixed", "id=42 名前: Zoë 😀 статус=ok Ωmega ✓ done. "},
+};
+
+size_t sink = 0;
+
+// The textbook decoder: reject overlong forms, surrogates and values past
+// U+10FFFF one sequence at a time.
+bool ValidateReference(const char* data, size_t length) {
+  auto* bytes = reinterpret_cast<const unsigned char*>(data);
+  size_t i = 0;
+  while (i < length) {
+    unsigned char lead = bytes[i];
+    size_t width;
+    char32_t code_point;
+    if (lead < 0x80) {
+      ++i;
+      continue;
+    } else if ((lead & 0xE0) == 0xC0) {
+      width = 2;
+      code_point = lead & 0x1F;
+    } else if ((lead & 0xF0) == 0xE0) {
+      width = 3;
+      code_point = lead & 0x0F;
+    } else if ((lead & 0xF8) == 0xF0) {
+      width = 4;
+      code_point = lead & 0x07;
+    } else {
+      return false;
+    }
+    if (i + width > length) {
+      return false;
+    }
+    for (size_t j = 1; j < width; ++j) {
+      if ((bytes[i + j] & 0xC0) != 0x80) {
+        return false;
+      }
+      code_point = (code_point << 6) | (bytes[i + j] & 0x3F);
+    }
+    const char32_t kMinimum[] = {0, 0, 0x80, 0x800, 0x10000};
+    if (code_point < kMinimum[width] or code_point > 0x10FFFF or
+        (code_point >= 0xD800 and code_point <= 0xDFFF)) {
+      return false;
+    }
+    i += width;
+  }
+  return true;
+}
+
+template <typename Operation>
+double GigabytesPerSecond(Operation operation) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kRepeats; ++i) {
+    sink += operation();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return double(kCorpusSize) * kRepeats / elapsed.count() / 1e9;
+}
+
+void Expect(bool condition, const char* what) {
+  if (!condition) {
+    std::fprintf(stderr, "FAILED: %s\n", what);
+    std::exit(1);
+  }
+}
+
+void Run(const Sample& sample) {
+  String corpus;
+  corpus.reserve(kCorpusSize);
+  StringView piece = sample.text;
+  while (corpus.length() + piece.length() <= kCorpusSize) {
+    corpus += piece;
+  }
+  corpus += String(kCorpusSize - corpus.length(), ' ');
+  const char* data = corpus.data();
+  size_t length = corpus.length();
+
+  size_t reference_count = 0;
+  for (size_t i = 0; i < length; ++i) {
+    reference_count += (static_cast<unsigned char>(data[i]) & 0xC0) != 0x80;
+  }
+  Expect(corpus.is_valid_utf8() and ValidateReference(data, length),
+         "both validators accept the corpus");
+  Expect(CountCodePoints(data, length) == reference_count,
+         "CountCodePoints matches the reference count");
+
+  double validate = GigabytesPerSecond(
+      [&] { return IsValidUtf8(data, length) ? 1 : 0; });
+  double validate_reference = GigabytesPerSecond(
+      [&] { return ValidateReference(data, length) ? 1 : 0; });
+  double count = GigabytesPerSecond(
+      [&] { return CountCodePoints(data, length); });
+  double iterate = GigabytesPerSecond([&] {
+    size_t total = 0;
+    for (char32_t code_point : corpus.code_points()) {
+      total += code_point;
+    }
+    return total;
+  });
+  String copy = corpus;
+  double lower = GigabytesPerSecond([&] {
+    copy.to_lower();
+    return size_t(copy[0]);
+  });
+  double lower_reference = GigabytesPerSecond([&] {
+    char* bytes = copy.data();
+    for (size_t i = 0; i < length; ++i) {
+      bytes[i] = static_cast<char>(
+          std::tolower(static_cast<unsigned char>(bytes[i])));
+    }
+    return size_t(bytes[0]);
+  });
+  std::printf("%-9s %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n", sample.name,
+              validate, validate_reference, count, iterate, lower,
+              lower_reference);
+}
+
+}  // namespace
+
+int main() {
+  std::printf("GB/s      validate reference     count   iterate  to_lower"
+              "   tolower\n");
+  for (const Sample& sample : kSamples) {
+    Run(sample);
+  }
+  std::printf("checksum %zu\n", sink);
+}